@@ -0,0 +1,179 @@
+"""
+End-to-end benchmarks over a local WebSocket connection: request round trips,
+handler dispatch, stream throughput and broadcast fan-out.
+
+Run with ``python -m pytest benchmarks/bench_network.py``. Results include the
+loopback network and both ends' encryption, so compare them only between runs
+on the same machine.
+"""
+
+import os
+import sys
+import threading
+import time
+
+import pytest
+
+src_dir = os.path.abspath(os.path.join(os.path.dirname(__file__), "..", "src"))
+sys.path.insert(0, src_dir)
+
+try:
+    import ObscuraProto as op
+except ImportError as e:
+    pytest.fail(f"Could not import the ObscuraProto package: {e}. Searched in: {sys.path}", pytrace=False)
+
+SESSION_PORT = 9101
+FANOUT_PORT = 9102
+
+OP_ECHO = 0x7101
+OP_COUNT = 0x7102
+OP_JOIN = 0x7103
+OP_NEWS = 0x8101
+
+DISPATCH_MESSAGES = 10_000
+STREAM_BYTES = 8 << 20
+FANOUT_CLIENTS = 16
+
+
+@pytest.fixture(scope="module")
+def session():
+    """A connected server/client pair shared by the single-connection benchmarks."""
+    op.Crypto.init()
+    server = op.Server()
+    counted = {"n": 0, "target": 0}
+    all_counted = threading.Event()
+    stream_done = threading.Event()
+
+    @server.on_anon_request(OP_ECHO)
+    def echo(hdl: op.ConnectionHdl, value: int) -> op.Payload:
+        return op.PayloadBuilder(OP_ECHO).add_param(value).build()
+
+    @server.on_anon_payload(OP_COUNT)
+    def count(hdl: op.ConnectionHdl, payload: op.Payload):
+        counted["n"] += 1
+        if counted["n"] == counted["target"]:
+            all_counted.set()
+
+    @server.on_incoming_stream
+    def incoming(stream: op.Stream):
+        @stream.on_complete
+        def done(data: bytes):
+            stream_done.set()
+
+    client = op.Client(server.public_key)
+    ready = threading.Event()
+    client.on_ready(ready.set)
+
+    server.start(SESSION_PORT)
+    time.sleep(0.1)
+    client.connect(f"ws://localhost:{SESSION_PORT}")
+    assert ready.wait(timeout=5), "Client did not become ready"
+    try:
+        yield {
+            "server": server,
+            "client": client,
+            "counted": counted,
+            "all_counted": all_counted,
+            "stream_done": stream_done,
+        }
+    finally:
+        client.disconnect()
+        server.stop()
+        time.sleep(0.1)
+
+
+def test_sync_request_rtt(benchmark, session):
+    payload = op.PayloadBuilder(OP_ECHO).add_param(1).build()
+    benchmark(session["client"].sync_request, payload)
+
+
+def test_request_many_100(benchmark, session):
+    payloads = [op.PayloadBuilder(OP_ECHO).add_param(i).build() for i in range(100)]
+    benchmark(session["client"].request_many, payloads, 16)
+
+
+def test_handler_dispatch(benchmark, session):
+    """Time to deliver DISPATCH_MESSAGES payloads to an auto-unpacking server handler."""
+    client = session["client"]
+    payload = op.PayloadBuilder(OP_COUNT).add_param("tick").build()
+
+    def setup():
+        session["counted"].update(n=0, target=DISPATCH_MESSAGES)
+        session["all_counted"].clear()
+
+    def run():
+        for _ in range(DISPATCH_MESSAGES):
+            client.send(payload)
+        assert session["all_counted"].wait(timeout=30)
+
+    benchmark.pedantic(run, setup=setup, rounds=5)
+
+
+def test_stream_throughput_8mib(benchmark, session):
+    client = session["client"]
+    data = os.urandom(STREAM_BYTES)
+
+    def run():
+        session["stream_done"].clear()
+        stream = client.start_stream()
+        stream.write_large(data, 64 * 1024)
+        stream.end()
+        assert session["stream_done"].wait(timeout=30)
+
+    benchmark.pedantic(run, rounds=5)
+
+
+def test_broadcast_fan_out(benchmark):
+    """One broadcast_anonymous() call reaching FANOUT_CLIENTS connected clients."""
+    op.Crypto.init()
+    server = op.Server()
+    hdls = []
+    joined = threading.Event()
+
+    @server.on_anon_payload(OP_JOIN)
+    def join(hdl: op.ConnectionHdl, payload: op.Payload):
+        hdls.append(hdl)
+        if len(hdls) == FANOUT_CLIENTS:
+            joined.set()
+
+    received = {"n": 0}
+    lock = threading.Lock()
+    all_received = threading.Event()
+
+    def on_news(payload: op.Payload):
+        with lock:
+            received["n"] += 1
+            if received["n"] == FANOUT_CLIENTS:
+                all_received.set()
+
+    clients = []
+    server.start(FANOUT_PORT)
+    time.sleep(0.1)
+    try:
+        for _ in range(FANOUT_CLIENTS):
+            client = op.Client(server.public_key)
+            ready = threading.Event()
+            client.on_ready(ready.set)
+            client.on_payload(OP_NEWS)(on_news)
+            client.connect(f"ws://localhost:{FANOUT_PORT}")
+            assert ready.wait(timeout=5), "Client did not become ready"
+            client.send(op.PayloadBuilder(OP_JOIN).build())
+            clients.append(client)
+        assert joined.wait(timeout=5), "Not every client joined"
+
+        news = op.PayloadBuilder(OP_NEWS).add_param(b"\x00" * 256).build()
+
+        def setup():
+            received["n"] = 0
+            all_received.clear()
+
+        def run():
+            server.broadcast_anonymous(news, hdls, workers=4)
+            assert all_received.wait(timeout=10)
+
+        benchmark.pedantic(run, setup=setup, rounds=20)
+    finally:
+        for client in clients:
+            client.disconnect()
+        server.stop()
+        time.sleep(0.1)
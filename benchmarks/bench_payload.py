@@ -0,0 +1,118 @@
+"""
+Micro-benchmarks for payload encoding and decoding across the binding.
+
+Run with ``python -m pytest benchmarks/bench_payload.py``.
+"""
+
+import array
+import os
+import sys
+
+import pytest
+
+src_dir = os.path.abspath(os.path.join(os.path.dirname(__file__), "..", "src"))
+sys.path.insert(0, src_dir)
+
+try:
+    import ObscuraProto as op
+except ImportError as e:
+    pytest.fail(f"Could not import the ObscuraProto package: {e}. Searched in: {sys.path}", pytrace=False)
+
+OP_TELEMETRY = 0x3001
+SCHEMA = op.compile_schema(str, op.uint, float, bool, bytes)
+VALUES = ("cpu", 7, 0.93, True, b"\x00" * 64)
+BLOB = os.urandom(1 << 20)
+SAMPLES = array.array("f", range(10_000))
+
+
+def build_telemetry():
+    return (
+        op.PayloadBuilder(OP_TELEMETRY)
+        .add_param(VALUES[0])
+        .add_param(VALUES[1])
+        .add_param(VALUES[2])
+        .add_param(VALUES[3])
+        .add_param(VALUES[4])
+        .build()
+    )
+
+
+def test_builder_add_param_chain(benchmark):
+    benchmark(build_telemetry)
+
+
+def test_builder_build_from(benchmark):
+    benchmark(op.PayloadBuilder.build_from, OP_TELEMETRY, VALUES, SCHEMA)
+
+
+def test_reader_read_one_by_one(benchmark):
+    payload = build_telemetry()
+
+    def read():
+        reader = op.PayloadReader(payload)
+        return (reader.read_string(), reader.read_uint(), reader.read_float(), reader.read_bool(), reader.read_bytes())
+
+    benchmark(read)
+
+
+def test_reader_read_all(benchmark):
+    payload = build_telemetry()
+    benchmark(lambda: op.PayloadReader(payload).read_all(SCHEMA))
+
+
+def test_large_blob_read_bytes(benchmark):
+    payload = op.PayloadBuilder(OP_TELEMETRY).add_param(BLOB).build()
+    benchmark(lambda: op.PayloadReader(payload).read_bytes())
+
+
+def test_large_blob_read_bytes_view(benchmark):
+    payload = op.PayloadBuilder(OP_TELEMETRY).add_param(BLOB).build()
+    benchmark(lambda: op.PayloadView(payload).read_bytes_view())
+
+
+def test_float_samples_add_param_each(benchmark):
+    def build():
+        builder = op.PayloadBuilder(OP_TELEMETRY)
+        for sample in SAMPLES:
+            builder.add_param(sample)
+        return builder.build()
+
+    benchmark(build)
+
+
+def test_float_samples_add_array(benchmark):
+    benchmark(lambda: op.PayloadBuilder(OP_TELEMETRY).add_array(SAMPLES, op.ParamType.FLOAT32_ARRAY).build())
+
+
+def test_float_samples_read_array_view(benchmark):
+    payload = op.PayloadBuilder(OP_TELEMETRY).add_array(SAMPLES, op.ParamType.FLOAT32_ARRAY).build()
+    benchmark(lambda: op.PayloadView(payload).read_array(op.ParamType.FLOAT32_ARRAY))
+
+
+def test_auto_unpacking_dispatch(benchmark):
+    """Cost of the decorator wrapper: schema decode plus the Python handler call."""
+
+    def handler(name: str, core: op.uint, load: float, busy: bool, raw: bytes):
+        pass
+
+    wrapper = op._create_unpacking_handler(handler)
+    payload = op.PayloadBuilder.build_from(OP_TELEMETRY, VALUES, SCHEMA)
+    benchmark(wrapper, payload)
+
+
+def test_crypto_encrypt_4k(benchmark):
+    op.Crypto.init()
+    client_kx = op.Crypto.generate_kx_keypair()
+    server_kx = op.Crypto.generate_kx_keypair()
+    key = op.Crypto.client_compute_session_keys(client_kx, server_kx.public_key).tx
+    message = list(os.urandom(4096))
+    benchmark(op.Crypto.encrypt, message, key)
+
+
+def test_crypto_encrypt_batch_64x4k(benchmark):
+    op.Crypto.init()
+    client_kx = op.Crypto.generate_kx_keypair()
+    server_kx = op.Crypto.generate_kx_keypair()
+    key = op.Crypto.client_compute_session_keys(client_kx, server_kx.public_key).tx
+    messages = [os.urandom(4096) for _ in range(64)]
+    benchmark(op.Crypto.encrypt_batch, key, messages)
@@ -0,0 +1,91 @@
+// Benchmarks for the ObscuraProto primitives the bindings sit on top of, so a
+// regression can be attributed to the C++ library or to the binding layer.
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+
+#include <obscuraproto/crypto.hpp>
+#include <obscuraproto/packet.hpp>
+
+using namespace ObscuraProto;
+
+static Payload make_telemetry(size_t blob_size) {
+    return PayloadBuilder(0x3001)
+        .add_param(std::string("cpu"))
+        .add_param(static_cast<uint8_t>(7))
+        .add_param(0.93)
+        .add_param(true)
+        .add_param(byte_vector(blob_size, 0x5A))
+        .build();
+}
+
+static void BM_PayloadBuild(benchmark::State &state) {
+    auto blob_size = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(make_telemetry(blob_size));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_PayloadBuild)->Arg(64)->Arg(4096)->Arg(1 << 20);
+
+static void BM_PayloadSerialize(benchmark::State &state) {
+    Payload payload = make_telemetry(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(payload.serialize());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_PayloadSerialize)->Arg(64)->Arg(4096)->Arg(1 << 20);
+
+static void BM_PayloadDeserialize(benchmark::State &state) {
+    byte_vector wire = make_telemetry(static_cast<size_t>(state.range(0))).serialize();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Payload::deserialize(wire));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_PayloadDeserialize)->Arg(64)->Arg(4096)->Arg(1 << 20);
+
+static void BM_PayloadReader(benchmark::State &state) {
+    Payload payload = make_telemetry(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        PayloadReader reader(payload);
+        benchmark::DoNotOptimize(reader.read_param<std::string>());
+        benchmark::DoNotOptimize(reader.read_param<uint8_t>());
+        benchmark::DoNotOptimize(reader.read_param<double>());
+        benchmark::DoNotOptimize(reader.read_param<bool>());
+        benchmark::DoNotOptimize(reader.read_param<byte_vector>());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_PayloadReader)->Arg(64)->Arg(4096)->Arg(1 << 20);
+
+static Crypto::SessionKeys make_session_keys() {
+    Crypto::init();
+    auto client_kx = Crypto::generate_kx_keypair();
+    auto server_kx = Crypto::generate_kx_keypair();
+    return Crypto::client_compute_session_keys(client_kx, server_kx.public_key);
+}
+
+static void BM_CryptoEncrypt(benchmark::State &state) {
+    auto keys = make_session_keys();
+    byte_vector message(static_cast<size_t>(state.range(0)), 0x42);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Crypto::encrypt(message, keys.tx));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_CryptoEncrypt)->Arg(64)->Arg(4096)->Arg(1 << 20);
+
+static void BM_CryptoDecrypt(benchmark::State &state) {
+    auto keys = make_session_keys();
+    byte_vector ciphertext = Crypto::encrypt(byte_vector(static_cast<size_t>(state.range(0)), 0x42), keys.tx);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Crypto::decrypt(ciphertext, keys.tx));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_CryptoDecrypt)->Arg(64)->Arg(4096)->Arg(1 << 20);
+
+BENCHMARK_MAIN();
@@ -3,7 +3,11 @@ ObscuraProto high-level Python library.
 """
 
 import asyncio  # Added for asyncio integration
+import functools
 import inspect
+import os
+import threading
+from collections.abc import Buffer, Iterable
 
 try:
     # This is the C++ extension module built by CMake.
@@ -64,12 +68,40 @@ class uint(int):
     pass
 
 
+class int32_array:
+    """A marker type for function signature hints.
+    Indicates that a parameter is a packed array of int32 values. Handlers receive a
+    memoryview with format ``'i'`` pointing into the payload; ``build_from`` accepts any
+    buffer of int32 values, such as ``array.array("i")`` or a numpy int32 array.
+
+    Example:
+        @server.on_payload(0x1235)
+        def my_handler(counts: int32_array):
+            total = sum(counts)  # or numpy.frombuffer(counts, numpy.int32).sum()
+    """
+
+
+class int64_array:
+    """A marker type for an int64 array parameter (memoryview format ``'q'``). See :class:`int32_array`."""
+
+
+class float32_array:
+    """A marker type for a float32 array parameter (memoryview format ``'f'``). See :class:`int32_array`."""
+
+
+class float64_array:
+    """A marker type for a float64 array parameter (memoryview format ``'d'``). See :class:`int32_array`."""
+
+
 # --- Re-export low-level components ---
 Role = _bindings.Role
 Crypto = _bindings.Crypto
 Payload = _bindings.Payload
 PayloadBuilder = _bindings.PayloadBuilder
 PayloadReader = _bindings.PayloadReader
+PayloadView = _bindings.PayloadView
+PayloadSchema = _bindings.PayloadSchema
+ParamType = _bindings.ParamType
 KeyPair = _bindings.KeyPair
 PublicKey = _bindings.PublicKey
 PrivateKey = _bindings.PrivateKey
@@ -77,6 +109,8 @@ V1_0 = _bindings.V1_0
 SUPPORTED_VERSIONS = _bindings.SUPPORTED_VERSIONS
 ConnectionHdl = _bindings.ConnectionHdl
 CppStream = _bindings.CppStream
+set_max_request_threads = _bindings.set_max_request_threads
+max_request_threads = _bindings.max_request_threads
 
 # Config
 Config = _bindings.Config
@@ -87,6 +121,101 @@ TimeoutConfig = _bindings.TimeoutConfig
 ReservedOpcodes = _bindings.ReservedOpcodes
 
 
+def _resolve_future(future, response, error):
+    """Completes an asyncio future on its event loop, unless it was cancelled meanwhile."""
+    if future.done():
+        return
+    if error is not None:
+        future.set_exception(error)
+    else:
+        future.set_result(response)
+
+
+async def _native_request(start, *args) -> Payload:
+    """
+    Internal helper to await a native non-blocking request. ``start`` is one of the
+    C++ ``*_async`` request methods; it completes the future through
+    ``loop.call_soon_threadsafe`` instead of occupying an executor thread. If the
+    await is cancelled, e.g. by a ``timeout``, a request still queued for a native
+    thread is dropped and never sent.
+    """
+    loop = asyncio.get_running_loop()
+    future = loop.create_future()
+    pending = start(*args, functools.partial(loop.call_soon_threadsafe, _resolve_future, future))
+    try:
+        return await future
+    except asyncio.CancelledError:
+        pending.cancel()
+        raise
+
+
+async def _gather_requests(request, payloads, max_in_flight) -> list[Payload]:
+    """
+    Internal helper that awaits ``request(payload)`` for every payload with at most
+    ``max_in_flight`` outstanding, returning the responses in order.
+    """
+    if max_in_flight < 1:
+        raise ValueError("max_in_flight must be at least 1")
+    window = asyncio.Semaphore(max_in_flight)
+
+    async def bounded(payload):
+        async with window:
+            return await request(payload)
+
+    return list(await asyncio.gather(*(bounded(payload) for payload in payloads)))
+
+
+def stats_to_prometheus(stats, prefix="obscuraproto") -> str:
+    """Renders a ``stats()`` dict in the Prometheus text exposition format.
+
+    Counters become ``*_total`` counters. Latencies become summaries in seconds
+    (``quantile`` series, ``_sum`` and ``_count``) with a ``*_max_seconds`` gauge.
+
+    Example:
+        print(stats_to_prometheus(server.stats(), prefix="game_server"))
+    """
+    families = {}
+
+    def sample(family, kind, value, suffix="", **labels):
+        rendered = ",".join(f'{key}="{label}"' for key, label in labels.items())
+        samples = families.setdefault(f"{prefix}_{family}", (kind, []))[1]
+        samples.append(f"{prefix}_{family}{suffix}{{{rendered}}} {value}" if rendered
+                       else f"{prefix}_{family}{suffix} {value}")
+
+    def latency(name, histogram, **labels):
+        # A summary in seconds, plus the slowest sample seen as a gauge.
+        family = f"{name}_seconds"
+        for quantile, key in (("0.5", "p50_us"), ("0.9", "p90_us"), ("0.99", "p99_us")):
+            sample(family, "summary", histogram[key] / 1e6, quantile=quantile, **labels)
+        sample(family, "summary", histogram["sum_us"] / 1e6, "_sum", **labels)
+        sample(family, "summary", histogram["count"], "_count", **labels)
+        sample(f"{name}_max_seconds", "gauge", histogram["max_us"] / 1e6, **labels)
+
+    for direction in ("received", "sent"):
+        sample(f"{direction}_messages_total", "counter", stats[direction]["messages"])
+        sample(f"{direction}_bytes_total", "counter", stats[direction]["bytes"])
+    latency("request_rtt", stats["request_rtt_us"])
+    for op_code, op_stats in sorted(stats["opcodes"].items()):
+        opcode = f"0x{op_code:04x}"
+        sample("opcode_received_messages_total", "counter", op_stats["messages"], opcode=opcode)
+        sample("opcode_received_bytes_total", "counter", op_stats["bytes"], opcode=opcode)
+        latency("handler", op_stats["handler_us"], opcode=opcode)
+
+    lines = []
+    for family, (kind, samples) in families.items():
+        lines.append(f"# TYPE {family} {kind}")
+        lines.extend(samples)
+    return "\n".join(lines) + "\n"
+
+
+# Default cap for Stream.on_complete reassembly, matching CppStream.set_collect_handler.
+_COMPLETE_MAX_SIZE = 64 << 20
+
+# Default Stream.write_large / send_file chunk size, matching DEFAULT_CHUNK_SIZE in
+# the bindings. A full chunk fits the default max_decrypted_payload of 65535 bytes.
+_DEFAULT_CHUNK_SIZE = 16 << 10
+
+
 class Stream:
     """A bidirectional, multiplexed data stream over an encrypted WebSocket.
 
@@ -107,10 +236,31 @@ class Stream:
 
     # --- Synchronous I/O (use inside C++ callbacks) ---
 
-    def write(self, data: bytes):
-        """Send a data chunk over the stream (thread-safe, releases GIL)."""
+    def write(self, data: Buffer):
+        """Send a data chunk over the stream (thread-safe, releases GIL).
+
+        Accepts any bytes-like object (bytes, bytearray, memoryview, numpy arrays).
+        """
         self._s.write(data)
 
+    def write_many(self, chunks: Iterable[Buffer]):
+        """Send several bytes-like objects as one data chunk, without concatenating them in Python."""
+        self._s.write_many(chunks)
+
+    def write_large(self, data: Buffer, chunk_size: int = _DEFAULT_CHUNK_SIZE):
+        """Send a large bytes-like object as ``chunk_size`` data chunks in a single native call.
+
+        Keep ``chunk_size`` below the peer's ``message_limits.max_decrypted_payload``.
+        """
+        self._s.write_large(data, chunk_size)
+
+    def send_file(self, path: str | os.PathLike, chunk_size: int = _DEFAULT_CHUNK_SIZE) -> int:
+        """Stream a file in ``chunk_size`` data chunks, read natively with the GIL released.
+
+        Returns the number of bytes sent. Does not end the stream.
+        """
+        return self._s.send_file(os.fspath(path), chunk_size)
+
     def end(self):
         """Signal end of outgoing data (half-close, releases GIL)."""
         self._s.end()
@@ -121,17 +271,29 @@ class Stream:
 
     # --- Async I/O (use inside async code) ---
 
-    async def async_write(self, data: bytes):
-        """Send a data chunk without blocking the event loop."""
-        await asyncio.to_thread(self._s.write, data)
+    # Stream I/O only encrypts and queues the frame (with the GIL released), so the
+    # async variants run inline rather than paying for an executor round trip.
+
+    async def async_write(self, data: Buffer):
+        """Send a data chunk from a coroutine.
+
+        Runs inline on the event loop: the chunk is encrypted and queued with the GIL
+        released and the call never waits on the network, so no executor hop is needed.
+        For very large chunks prefer :meth:`write_large` from a worker thread.
+        """
+        self._s.write(data)
+
+    async def async_send_file(self, path: str | os.PathLike, chunk_size: int = _DEFAULT_CHUNK_SIZE) -> int:
+        """Stream a file without blocking the event loop on disk reads."""
+        return await asyncio.to_thread(self.send_file, path, chunk_size)
 
     async def async_end(self):
-        """Signal end of outgoing data without blocking the event loop."""
-        await asyncio.to_thread(self._s.end)
+        """Signal end of outgoing data from a coroutine. Runs inline; only queues a frame."""
+        self._s.end()
 
     async def async_cancel(self):
-        """Abort the stream without blocking the event loop."""
-        await asyncio.to_thread(self._s.cancel)
+        """Abort the stream from a coroutine. Runs inline; only queues a frame."""
+        self._s.cancel()
 
     # --- Decorator-style handler registration ---
 
@@ -144,11 +306,29 @@ class Stream:
             def on_chunk(data: bytes):
                 print(f"Got {len(data)} bytes")
         """
+        self._s.set_data_handler(handler)
+        return handler
+
+    def on_complete(self, handler=None, *, max_size=_COMPLETE_MAX_SIZE):
+        """Register a callback that receives all incoming data as one ``bytes`` object.
+
+        Chunks are reassembled natively and the handler runs once, when the remote
+        side ends the stream. This replaces any ``on_data`` / ``on_end`` handler.
+        If the peer sends more than ``max_size`` bytes (64 MiB by default), the
+        stream is cancelled, the buffered data is freed and the handler is not called.
+
+        Can be used as a decorator::
 
-        def wrapper(data_list):
-            handler(bytes(data_list))
+            @stream.on_complete
+            def on_file(data: bytes):
+                print(f"Got the whole file: {len(data)} bytes")
 
-        self._s.set_data_handler(wrapper)
+            @stream.on_complete(max_size=1 << 20)
+            def on_small_file(data: bytes): ...
+        """
+        if handler is None:
+            return functools.partial(self.on_complete, max_size=max_size)
+        self._s.set_collect_handler(handler, max_size)
         return handler
 
     def on_end(self, handler):
@@ -176,11 +356,70 @@ class Stream:
         return handler
 
 
+# Maps the type hints supported by auto-unpacking to native schema parameter types.
+_SCHEMA_TYPES = {
+    str: ParamType.STRING,
+    int: ParamType.INT,
+    uint: ParamType.UINT,
+    float: ParamType.FLOAT,
+    bool: ParamType.BOOL,
+    bytes: ParamType.BYTES,
+    memoryview: ParamType.BYTES_VIEW,
+    int32_array: ParamType.INT32_ARRAY,
+    int64_array: ParamType.INT64_ARRAY,
+    float32_array: ParamType.FLOAT32_ARRAY,
+    float64_array: ParamType.FLOAT64_ARRAY,
+}
+
+# Hints decoded as memoryviews into the received payload, which only a PayloadView can do.
+_VIEW_HINTS = (memoryview, int32_array, int64_array, float32_array, float64_array)
+
+
+def compile_schema(*type_hints) -> PayloadSchema:
+    """Compiles Python type hints into a reusable PayloadSchema.
+
+    Supported hints are ``str``, ``int``, ``uint``, ``float``, ``bool``, ``bytes``,
+    ``memoryview`` and the array markers ``int32_array``, ``int64_array``,
+    ``float32_array`` and ``float64_array``. ``memoryview`` and array parameters are read
+    with PayloadView.read_all() as views into the payload instead of copies. Compile a
+    schema once and reuse it for every message.
+
+    Example:
+        TELEMETRY = compile_schema(str, uint, float)
+        payload = PayloadBuilder.build_from(0x3001, ("cpu", 7, 0.93), TELEMETRY)
+        name, core, load = PayloadReader(payload).read_all(TELEMETRY)
+    """
+    types = []
+    for hint in type_hints:
+        try:
+            types.append(_SCHEMA_TYPES[hint])
+        except (KeyError, TypeError):
+            raise TypeError(f"Unsupported type hint for a payload schema: {hint!r}") from None
+    return PayloadSchema(types)
+
+
+def _compile_schema(handler, params):
+    """
+    Internal helper to compile the type hints of a handler's parameters into a
+    native PayloadSchema. This runs once at registration time, so each message
+    is decoded with a single PayloadReader.read_all() call.
+    """
+    types = []
+    for param in params:
+        try:
+            types.append(_SCHEMA_TYPES[param.annotation])
+        except (KeyError, TypeError):
+            raise TypeError(
+                f"Handler '{handler.__name__}' has an unsupported or missing type hint for parameter '{param.name}'."
+            ) from None
+    return PayloadSchema(types)
+
+
 def _create_unpacking_handler(handler, receives_hdl_from_native=False):
     """
     Internal helper to create a wrapper function that intelligently calls a handler
     by inspecting its type hints. It can pass the connection handle, the raw payload,
-    or auto-unpacked arguments.
+    a PayloadView over it, or auto-unpacked arguments.
     """
     sig = inspect.signature(handler)
     params = sig.parameters
@@ -192,7 +431,7 @@ def _create_unpacking_handler(handler, receives_hdl_from_native=False):
     for param in params.values():
         if param.annotation is ConnectionHdl:
             hdl_param = param
-        elif param.annotation is Payload:
+        elif param.annotation is Payload or param.annotation is PayloadView:
             payload_param = param
         elif param.annotation is not param.empty:
             unpack_params.append(param)
@@ -209,6 +448,11 @@ def _create_unpacking_handler(handler, receives_hdl_from_native=False):
             "parameters and a 'Payload' parameter. Choose one method."
         )
 
+    schema = _compile_schema(handler, unpack_params) if unpack_params else None
+    unpack_names = [param.name for param in unpack_params]
+    wants_view = payload_param is not None and payload_param.annotation is PayloadView
+    reader_type = PayloadView if any(param.annotation in _VIEW_HINTS for param in unpack_params) else PayloadReader
+
     # --- Create the specialized wrapper ---
     def unpacking_wrapper(*args):
         # Determine what C++ passed us based on the context
@@ -221,31 +465,14 @@ def _create_unpacking_handler(handler, receives_hdl_from_native=False):
             handler_kwargs[hdl_param.name] = hdl
 
         if payload_param:
-            handler_kwargs[payload_param.name] = payload
+            handler_kwargs[payload_param.name] = PayloadView(payload) if wants_view else payload
             # When using raw payload, no further unpacking is done.
             return handler(**handler_kwargs)
 
-        # If there are params to unpack, do it.
-        if unpack_params:
-            reader = PayloadReader(payload)
-            type_map = {
-                str: reader.read_string,
-                int: reader.read_int,
-                uint: reader.read_uint,
-                float: reader.read_float,
-                bool: reader.read_bool,
-                bytes: reader.read_bytes,
-            }
-
+        # If there are params to unpack, decode them all in one native call.
+        if schema is not None:
             try:
-                for param in unpack_params:
-                    type_hint = param.annotation
-                    if type_hint in type_map:
-                        handler_kwargs[param.name] = type_map[type_hint]()
-                    else:
-                        # This case covers missing or unsupported type hints for unpacking
-                        raise TypeError(f"Unsupported or missing type hint for parameter '{param.name}'.")
-
+                handler_kwargs.update(zip(unpack_names, reader_type(payload).read_all(schema)))
             except Exception as e:
                 op_code_hex = f"0x{payload.op_code:04x}" if payload else "N/A"
                 print(
@@ -262,6 +489,40 @@ def _create_unpacking_handler(handler, receives_hdl_from_native=False):
     return unpacking_wrapper
 
 
+def _offload_handler(wrapper, handler, executor, max_pending, on_overload):
+    """
+    Internal helper that makes a native payload handler submit ``wrapper`` to
+    ``executor`` instead of running it on the WebSocket I/O thread.
+
+    At most ``max_pending`` calls may be queued or running. Further payloads are
+    passed to ``on_overload`` (with the handler's native arguments) on the I/O
+    thread, or dropped if it is None, so a slow handler cannot grow the queue
+    without bound.
+    """
+    if max_pending < 1:
+        raise ValueError("max_pending must be at least 1")
+    slots = threading.BoundedSemaphore(max_pending)
+
+    def finished(future):
+        slots.release()
+        if not future.cancelled() and future.exception() is not None:
+            print(f"[ERROR] Handler '{handler.__name__}' raised on its executor: {future.exception()!r}")
+
+    def submitting_wrapper(*args):
+        if not slots.acquire(blocking=False):
+            if on_overload is not None:
+                on_overload(*args)
+            return
+        try:
+            future = executor.submit(wrapper, *args)
+        except BaseException:
+            slots.release()
+            raise
+        future.add_done_callback(finished)
+
+    return submitting_wrapper
+
+
 def _create_request_unpacking_handler(handler, receives_hdl_from_native=False):
     """
     Internal helper to create a wrapper function for request handlers.
@@ -283,6 +544,13 @@ def _create_request_unpacking_handler(handler, receives_hdl_from_native=False):
     else:
         unpack_params = param_list
 
+    # A handler may ask for the PayloadReader itself; it receives it after the typed
+    # parameters have been read, exactly as if they had been read one by one.
+    reader_names = [param.name for param in unpack_params if param.annotation is PayloadReader]
+    typed_params = [param for param in unpack_params if param.annotation is not PayloadReader]
+    schema = _compile_schema(handler, typed_params)
+    typed_names = [param.name for param in typed_params]
+
     def unpacking_request_wrapper(*args):
         # Determine what C++ passed us based on the context
         # For server: (hdl, reader_obj)
@@ -301,24 +569,10 @@ def _create_request_unpacking_handler(handler, receives_hdl_from_native=False):
         # Unpack parameters from the PayloadReader
         reader = reader_obj  # In C++, PayloadReader is passed by reference, Python gets a binding object
 
-        type_map = {
-            str: reader.read_string,
-            int: reader.read_int,
-            uint: reader.read_uint,
-            float: reader.read_float,
-            bool: reader.read_bool,
-            bytes: reader.read_bytes,
-        }
-
         try:
-            for param in unpack_params:
-                type_hint = param.annotation
-                if type_hint is PayloadReader:  # If the handler explicitly requests PayloadReader
-                    handler_kwargs[param.name] = reader
-                elif type_hint in type_map:
-                    handler_kwargs[param.name] = type_map[type_hint]()
-                else:
-                    raise TypeError(f"Unsupported or missing type hint for parameter '{param.name}'.")
+            handler_kwargs.update(zip(typed_names, reader.read_all(schema)))
+            for name in reader_names:
+                handler_kwargs[name] = reader
 
         except Exception as e:
             # We don't have opcode easily here, as it's extracted by C++ before passing PayloadReader
@@ -390,9 +644,58 @@ class Server:
         """Sends a payload to a specific client."""
         self._server.send(hdl, payload)
 
-    async def async_request(self, hdl, payload) -> Payload:
-        """Sends a request to a specific client and returns a future for the response."""
-        return await asyncio.to_thread(self._server.sync_request, hdl, payload)
+    def broadcast(self, payload, targets, workers=1) -> int:
+        """Sends the same payload to many clients in a single native call.
+
+        Args:
+            payload: The payload to send.
+            targets: An iterable of ConnectionHdl or of identity PublicKey objects (not mixed).
+            workers: Number of threads the per-session encryption is spread across.
+
+        Returns:
+            The number of clients the payload was queued for. Connections that
+            closed in the meantime are skipped.
+        """
+        return self._server.broadcast(payload, list(targets), workers)
+
+    def sync_request(self, hdl, payload, timeout=None) -> Payload:
+        """Sends a request to a specific client and blocks until the response arrives.
+
+        Raises ``TimeoutError`` if ``timeout`` seconds pass first. The GIL is released while waiting.
+        """
+        return self._server.sync_request(hdl, payload, timeout)
+
+    async def async_request(self, hdl, payload, timeout=None) -> Payload:
+        """Sends a request to a specific client and returns a future for the response.
+
+        Raises ``TimeoutError`` if ``timeout`` seconds pass first.
+        """
+        return await asyncio.wait_for(_native_request(self._server.request_async, hdl, payload), timeout)
+
+    def request_many(self, hdl, payloads, max_in_flight=8) -> list[Payload]:
+        """Sends many requests to one client and returns the responses in order.
+
+        Up to ``max_in_flight`` requests are outstanding at once, so a batch costs
+        roughly ``len(payloads) / max_in_flight`` round trips instead of one per request.
+        The window is capped at ``max_request_threads()``. Raises ``RuntimeError`` if any
+        request fails. Blocks the calling thread with the GIL released.
+        """
+        return self._server.request_many(hdl, list(payloads), max_in_flight)
+
+    async def async_request_many(self, hdl, payloads, max_in_flight=8) -> list[Payload]:
+        """Async variant of :meth:`request_many`."""
+        return await _gather_requests(functools.partial(self.async_request, hdl), payloads, max_in_flight)
+
+    def stats(self) -> dict:
+        """Returns counters and latency histograms for traffic that passed through the bindings.
+
+        The dict holds ``received`` / ``sent`` (``messages``, ``bytes``),
+        ``request_rtt_us`` and per-opcode ``opcodes`` entries (``messages``, ``bytes``,
+        ``handler_us``) for every registered handler. Histograms report ``count``,
+        ``sum_us``, ``mean_us``, ``max_us`` and ``p50_us`` / ``p90_us`` / ``p99_us``. Use
+        :func:`stats_to_prometheus` for a text export.
+        """
+        return self._server.stats()
 
     def start_stream(self, hdl):
         """Starts a new outgoing stream to a specific client.
@@ -429,7 +732,7 @@ class Server:
         self._server.register_incoming_stream_handler(wrapper)
         return handler
 
-    def on_payload(self, opcode):
+    def on_payload(self, opcode, executor=None, max_pending=1024, on_overload=None):
         """
         Decorator to register a handler for a specific opcode.
 
@@ -437,19 +740,54 @@ class Server:
         payload based on type hints. If no type hints are provided, it will be
         called with `(hdl, payload)`.
 
+        Pass a ``concurrent.futures.Executor`` as ``executor`` to run the handler
+        there instead of on the WebSocket I/O thread, so a slow handler does not
+        delay other connections. At most ``max_pending`` calls are queued or
+        running; further payloads go to ``on_overload(hdl, payload)`` on the I/O
+        thread (e.g. to send a "busy" reply), or are dropped if it is None.
+        Reply from the handler with :meth:`send`.
+
         Example:
             @server.on_payload(0x1001)
             def handle_login(hdl, username: str, password: str, attempt: uint):
                 print(f"Login attempt for '{username}'")
+
+            @server.on_payload(0x1004, executor=pool, max_pending=256)
+            def handle_query(hdl, query: str):
+                server.send(hdl, run_query(query))
         """
 
         def decorator(handler):
             wrapper = _create_unpacking_handler(handler, receives_hdl_from_native=True)
+            if executor is not None:
+                wrapper = _offload_handler(wrapper, handler, executor, max_pending, on_overload)
             self._server.register_op_handler(opcode, wrapper)
             return handler
 
         return decorator
 
+    def on_payload_batch(self, opcode, max_batch=64, max_delay_us=1000):
+        """
+        Decorator to register a batched handler for a specific opcode.
+
+        Payloads are queued natively and the handler is called with a list of
+        ``(hdl, payload)`` tuples once ``max_batch`` payloads are queued or the
+        oldest one has waited ``max_delay_us`` microseconds. The GIL is acquired
+        once per batch instead of once per message.
+
+        Example:
+            @server.on_payload_batch(0x1001, max_batch=256, max_delay_us=500)
+            def handle_telemetry(batch: list[tuple[ConnectionHdl, Payload]]):
+                for hdl, payload in batch:
+                    ...
+        """
+
+        def decorator(handler):
+            self._server.register_batch_op_handler(opcode, handler, max_batch, max_delay_us)
+            return handler
+
+        return decorator
+
     def default_payload_handler(self, handler):
         """
         Decorator for the default handler, with auto-unpacking based on type hints.
@@ -486,7 +824,11 @@ class Server:
         """Sends a payload to an anonymous session."""
         self._server.send_anonymous(hdl, payload)
 
-    def on_anon_payload(self, opcode):
+    def broadcast_anonymous(self, payload, hdls, workers=1) -> int:
+        """Sends the same payload to many anonymous sessions. See :meth:`broadcast`."""
+        return self._server.broadcast_anonymous(payload, list(hdls), workers)
+
+    def on_anon_payload(self, opcode, executor=None, max_pending=1024, on_overload=None):
         """
         Decorator to register a handler for a specific opcode on anonymous sessions.
 
@@ -494,6 +836,8 @@ class Server:
         payload based on type hints. If no type hints are provided, it will be
         called with `(hdl, payload)`.
 
+        ``executor``, ``max_pending`` and ``on_overload`` work as in :meth:`on_payload`.
+
         Example:
             @server.on_anon_payload(0x5001)
             def handle_anon_register(hdl, key_data: bytes):
@@ -502,11 +846,25 @@ class Server:
 
         def decorator(handler):
             wrapper = _create_unpacking_handler(handler, receives_hdl_from_native=True)
+            if executor is not None:
+                wrapper = _offload_handler(wrapper, handler, executor, max_pending, on_overload)
             self._server.register_anon_op_handler(opcode, wrapper)
             return handler
 
         return decorator
 
+    def on_anon_payload_batch(self, opcode, max_batch=64, max_delay_us=1000):
+        """
+        Decorator to register a batched handler for a specific opcode on anonymous sessions.
+        See :meth:`on_payload_batch`.
+        """
+
+        def decorator(handler):
+            self._server.register_anon_batch_op_handler(opcode, handler, max_batch, max_delay_us)
+            return handler
+
+        return decorator
+
     def anon_default_payload_handler(self, handler):
         """
         Decorator for the default handler for anonymous sessions,
@@ -572,13 +930,21 @@ class Server:
         """Sends a payload to a specific client identified by their public key."""
         self._server.send_to_identity(identity_pk, payload)
 
-    async def async_request_to_identity(self, identity_pk, payload) -> Payload:
-        """Sends a request to a client identified by their public key (async)."""
-        return await asyncio.to_thread(self._server.sync_request_to_identity, identity_pk, payload)
+    async def async_request_to_identity(self, identity_pk, payload, timeout=None) -> Payload:
+        """Sends a request to a client identified by their public key (async).
 
-    def sync_request_to_identity(self, identity_pk, payload) -> Payload:
-        """Sends a synchronous request to a client identified by their public key."""
-        return self._server.sync_request_to_identity(identity_pk, payload)
+        Raises ``TimeoutError`` if ``timeout`` seconds pass first.
+        """
+        return await asyncio.wait_for(
+            _native_request(self._server.request_to_identity_async, identity_pk, payload), timeout
+        )
+
+    def sync_request_to_identity(self, identity_pk, payload, timeout=None) -> Payload:
+        """Sends a synchronous request to a client identified by their public key.
+
+        Raises ``TimeoutError`` if ``timeout`` seconds pass first.
+        """
+        return self._server.sync_request_to_identity(identity_pk, payload, timeout)
 
 
 class Client:
@@ -635,9 +1001,44 @@ class Client:
         """Sends a payload to the server."""
         self._client.send(payload)
 
-    async def async_request(self, payload) -> Payload:
-        """Sends a request to the server and returns a future for the response."""
-        return await asyncio.to_thread(self._client.sync_request, payload)
+    def sync_request(self, payload, timeout=None) -> Payload:
+        """Sends a request to the server and blocks until the response arrives.
+
+        Raises ``TimeoutError`` if ``timeout`` seconds pass first. The GIL is released while waiting.
+        """
+        return self._client.sync_request(payload, timeout)
+
+    async def async_request(self, payload, timeout=None) -> Payload:
+        """Sends a request to the server and returns a future for the response.
+
+        Raises ``TimeoutError`` if ``timeout`` seconds pass first.
+        """
+        return await asyncio.wait_for(_native_request(self._client.request_async, payload), timeout)
+
+    def request_many(self, payloads, max_in_flight=8) -> list[Payload]:
+        """Sends many requests to the server and returns the responses in order.
+
+        Up to ``max_in_flight`` requests are outstanding at once, so a batch costs
+        roughly ``len(payloads) / max_in_flight`` round trips instead of one per request.
+        The window is capped at ``max_request_threads()``. Raises ``RuntimeError`` if any
+        request fails. Blocks the calling thread with the GIL released.
+        """
+        return self._client.request_many(list(payloads), max_in_flight)
+
+    async def async_request_many(self, payloads, max_in_flight=8) -> list[Payload]:
+        """Async variant of :meth:`request_many`."""
+        return await _gather_requests(self.async_request, payloads, max_in_flight)
+
+    def stats(self) -> dict:
+        """Returns counters and latency histograms for traffic that passed through the bindings.
+
+        The dict holds ``received`` / ``sent`` (``messages``, ``bytes``),
+        ``request_rtt_us`` and per-opcode ``opcodes`` entries (``messages``, ``bytes``,
+        ``handler_us``) for every registered handler. Histograms report ``count``,
+        ``sum_us``, ``mean_us``, ``max_us`` and ``p50_us`` / ``p90_us`` / ``p99_us``. Use
+        :func:`stats_to_prometheus` for a text export.
+        """
+        return self._client.stats()
 
     def start_stream(self):
         """Starts a new outgoing stream to the server.
@@ -705,6 +1106,26 @@ class Client:
 
         return decorator
 
+    def on_payload_batch(self, opcode, max_batch=64, max_delay_us=1000):
+        """
+        Decorator to register a batched handler for a specific opcode from the server.
+
+        The handler is called with a list of payloads once ``max_batch`` payloads
+        are queued or the oldest one has waited ``max_delay_us`` microseconds.
+
+        Example:
+            @client.on_payload_batch(0x2001)
+            def handle_updates(batch: list[Payload]):
+                for payload in batch:
+                    ...
+        """
+
+        def decorator(handler):
+            self._client.register_batch_op_handler(opcode, handler, max_batch, max_delay_us)
+            return handler
+
+        return decorator
+
     def default_payload_handler(self, handler):
         """
         Decorator for the default handler, with auto-unpacking based on type hints.
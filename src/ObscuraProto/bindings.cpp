@@ -3,7 +3,28 @@
 #include <pybind11/operators.h>
 #include <pybind11/functional.h>
 #include <pybind11/chrono.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <limits>
+#include <list>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include <obscuraproto/config.hpp>
 #include <obscuraproto/crypto.hpp>
@@ -30,6 +51,1506 @@ struct WsConnectionHdlWrapper {
     WsConnectionHdl hdl;
 };
 
+// RAII holder for a C-contiguous view over any bytes-like object
+// (bytes, bytearray, memoryview, numpy arrays, ...). The exporter stays
+// locked for the lifetime of the view, so the data can be read after the
+// GIL has been released.
+class ContiguousBuffer {
+public:
+    explicit ContiguousBuffer(const py::handle &obj, int flags = PyBUF_SIMPLE) {
+        if (PyObject_GetBuffer(obj.ptr(), &view_, flags) != 0) {
+            throw py::error_already_set();
+        }
+    }
+    ~ContiguousBuffer() { PyBuffer_Release(&view_); }
+
+    ContiguousBuffer(const ContiguousBuffer&) = delete;
+    ContiguousBuffer& operator=(const ContiguousBuffer&) = delete;
+
+    const uint8_t* data() const { return static_cast<const uint8_t*>(view_.buf); }
+    size_t size() const { return static_cast<size_t>(view_.len); }
+    byte_vector to_vector() const { return byte_vector(data(), data() + size()); }
+    // Only filled in when constructed with PyBUF_FORMAT.
+    std::string format() const { return view_.format ? view_.format : "B"; }
+    size_t itemsize() const { return static_cast<size_t>(view_.itemsize); }
+
+private:
+    Py_buffer view_;
+};
+
+// Native parameter types of a compiled payload schema. A schema is built
+// once (e.g. from a handler's type hints) and then decodes a whole payload
+// in a single call across the binding boundary.
+enum class ParamType : uint8_t {
+    STRING,
+    INT,
+    UINT,
+    FLOAT,
+    BOOL,
+    BYTES,
+    BYTES_VIEW,
+    INT32_ARRAY,
+    INT64_ARRAY,
+    FLOAT32_ARRAY,
+    FLOAT64_ARRAY,
+};
+
+struct PayloadSchema {
+    std::vector<ParamType> types;
+};
+
+// Numeric arrays travel as a single bytes parameter holding the packed
+// elements in little-endian order, so a C++ peer reads them with
+// read_param<byte_vector>() and decodes them with one memcpy on common
+// hardware. On little-endian hosts encoding is a copy and decoding from a
+// PayloadView is a cast of a memoryview into the payload; only big-endian
+// data is byte-swapped.
+struct ArrayFormat {
+    size_t itemsize;
+    bool floating;
+    const char *format;  // struct-module format of the decoded memoryview
+    const char *name;
+};
+
+static const ArrayFormat *array_format(ParamType type) {
+    static const ArrayFormat int32{4, false, "i", "int32"};
+    static const ArrayFormat int64{8, false, "q", "int64"};
+    static const ArrayFormat float32{4, true, "f", "float32"};
+    static const ArrayFormat float64{8, true, "d", "float64"};
+    switch (type) {
+        case ParamType::INT32_ARRAY:
+            return &int32;
+        case ParamType::INT64_ARRAY:
+            return &int64;
+        case ParamType::FLOAT32_ARRAY:
+            return &float32;
+        case ParamType::FLOAT64_ARRAY:
+            return &float64;
+        default:
+            return nullptr;
+    }
+}
+
+static const ArrayFormat &checked_array_format(ParamType type) {
+    const ArrayFormat *format = array_format(type);
+    if (!format) {
+        throw py::value_error("Expected an array ParamType (INT32_ARRAY, INT64_ARRAY, FLOAT32_ARRAY or FLOAT64_ARRAY)");
+    }
+    return *format;
+}
+
+static bool host_is_little_endian() {
+    const uint16_t probe = 1;
+    uint8_t first;
+    std::memcpy(&first, &probe, 1);
+    return first == 1;
+}
+
+// Reverses the bytes of each Width-sized element. The fixed width lets the
+// compiler unroll and vectorize the inner loop.
+template <size_t Width>
+static void copy_byteswapped(const uint8_t *src, uint8_t *dst, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        for (size_t b = 0; b < Width; ++b) {
+            dst[i * Width + b] = src[i * Width + Width - 1 - b];
+        }
+    }
+}
+
+static void copy_byteswapped(const uint8_t *src, uint8_t *dst, size_t size, size_t itemsize) {
+    if (itemsize == 4) {
+        copy_byteswapped<4>(src, dst, size / 4);
+    } else {
+        copy_byteswapped<8>(src, dst, size / 8);
+    }
+}
+
+// Packs any buffer-protocol object (array.array, numpy arrays, memoryview.cast)
+// whose elements match `format` into the little-endian wire form.
+static byte_vector encode_array(const py::handle &value, const ArrayFormat &format) {
+    ContiguousBuffer buffer(value, PyBUF_FORMAT | PyBUF_C_CONTIGUOUS);
+    std::string code = buffer.format();
+    bool big_endian = !host_is_little_endian();
+    if (!code.empty() && std::string("@=<>!").find(code[0]) != std::string::npos) {
+        if (code[0] == '<') {
+            big_endian = false;
+        } else if (code[0] == '>' || code[0] == '!') {
+            big_endian = true;
+        }
+        code.erase(0, 1);
+    }
+    const char *accepted = format.floating ? "fd" : "bhilqn";
+    if (code.size() != 1 || std::string(accepted).find(code[0]) == std::string::npos ||
+        buffer.itemsize() != format.itemsize) {
+        throw py::type_error(std::string("Expected a buffer of ") + format.name + " values, got format '" +
+                             buffer.format() + "' with item size " + std::to_string(buffer.itemsize()));
+    }
+    if (!big_endian) {
+        return buffer.to_vector();
+    }
+    byte_vector packed(buffer.size());
+    copy_byteswapped(buffer.data(), packed.data(), buffer.size(), format.itemsize);
+    return packed;
+}
+
+// Turns the wire bytes of an array into a typed memoryview. `bytes_view` is a
+// 'B'-format memoryview over them; on little-endian hosts it is cast in place.
+static py::object decode_array(py::object bytes_view, const ArrayFormat &format) {
+    ContiguousBuffer buffer(bytes_view);
+    if (buffer.size() % format.itemsize != 0) {
+        throw std::runtime_error(std::string("Invalid size for a ") + format.name +
+                                 " array parameter: " + std::to_string(buffer.size()));
+    }
+    if (host_is_little_endian()) {
+        return bytes_view.attr("cast")(format.format);
+    }
+    std::string native(buffer.size(), '\0');
+    copy_byteswapped(buffer.data(), reinterpret_cast<uint8_t*>(native.data()), buffer.size(), format.itemsize);
+    return py::memoryview(py::bytes(native)).attr("cast")(format.format);
+}
+
+static int64_t read_signed(PayloadReader &reader) {
+    size_t size = reader.peek_next_param_size();
+    switch (size) {
+        case 1:
+            return reader.read_param<int8_t>();
+        case 2:
+            return reader.read_param<int16_t>();
+        case 4:
+            return reader.read_param<int32_t>();
+        case 8:
+            return reader.read_param<int64_t>();
+        default:
+            throw std::runtime_error("Invalid size for a signed integer parameter: " + std::to_string(size));
+    }
+}
+
+static uint64_t read_unsigned(PayloadReader &reader) {
+    size_t size = reader.peek_next_param_size();
+    switch (size) {
+        case 1:
+            return reader.read_param<uint8_t>();
+        case 2:
+            return reader.read_param<uint16_t>();
+        case 4:
+            return reader.read_param<uint32_t>();
+        case 8:
+            return reader.read_param<uint64_t>();
+        default:
+            throw std::runtime_error("Invalid size for an unsigned integer parameter: " + std::to_string(size));
+    }
+}
+
+static double read_floating(PayloadReader &reader) {
+    size_t size = reader.peek_next_param_size();
+    switch (size) {
+        case 4:
+            return reader.read_param<float>();
+        case 8:
+            return reader.read_param<double>();
+        default:
+            throw std::runtime_error("Invalid size for a float/double parameter: " + std::to_string(size));
+    }
+}
+
+static py::object read_typed_param(PayloadReader &reader, ParamType type) {
+    switch (type) {
+        case ParamType::STRING:
+            return py::str(reader.read_param<std::string>());
+        case ParamType::INT:
+            return py::int_(read_signed(reader));
+        case ParamType::UINT:
+            return py::int_(read_unsigned(reader));
+        case ParamType::FLOAT:
+            return py::float_(read_floating(reader));
+        case ParamType::BOOL:
+            return py::bool_(reader.read_param<bool>());
+        case ParamType::BYTES: {
+            byte_vector data = reader.read_param<byte_vector>();
+            return py::bytes(reinterpret_cast<const char*>(data.data()), data.size());
+        }
+        case ParamType::BYTES_VIEW: {
+            // A PayloadReader owns no Python buffer to point into, so the view
+            // wraps a copy. PayloadView.read_all() returns a true view.
+            byte_vector data = reader.read_param<byte_vector>();
+            return py::memoryview(py::bytes(reinterpret_cast<const char*>(data.data()), data.size()));
+        }
+        case ParamType::INT32_ARRAY:
+        case ParamType::INT64_ARRAY:
+        case ParamType::FLOAT32_ARRAY:
+        case ParamType::FLOAT64_ARRAY: {
+            byte_vector data = reader.read_param<byte_vector>();
+            return decode_array(py::memoryview(py::bytes(reinterpret_cast<const char*>(data.data()), data.size())),
+                                *array_format(type));
+        }
+    }
+    throw std::runtime_error("Unknown parameter type in payload schema");
+}
+
+static py::tuple read_all(PayloadReader &reader, const PayloadSchema &schema) {
+    py::tuple values(schema.types.size());
+    for (size_t i = 0; i < schema.types.size(); ++i) {
+        values[i] = read_typed_param(reader, schema.types[i]);
+    }
+    return values;
+}
+
+// Every encoded parameter is a fixed-width length prefix followed by the raw
+// value. PayloadView needs the prefix width and byte order to find values in
+// place; both are measured once from PayloadBuilder output so the view always
+// agrees with the C++ library it was built against.
+struct ParamLayout {
+    size_t prefix_size = 0;
+    bool big_endian = false;
+    // Whether ints, floats and bools are stored as their plain bytes in
+    // `scalars_big_endian` order, so PayloadView can decode them in place.
+    bool direct_scalars = false;
+    bool scalars_big_endian = false;
+
+    size_t decode_length(const uint8_t *prefix) const {
+        size_t length = 0;
+        for (size_t i = 0; i < prefix_size; ++i) {
+            length = (length << 8) | prefix[big_endian ? i : prefix_size - 1 - i];
+        }
+        return length;
+    }
+
+    template <typename T>
+    T decode_scalar(const uint8_t *value) const {
+        uint8_t bytes[sizeof(T)];
+        if (scalars_big_endian == !host_is_little_endian()) {
+            std::memcpy(bytes, value, sizeof(T));
+        } else {
+            std::reverse_copy(value, value + sizeof(T), bytes);
+        }
+        T result;
+        std::memcpy(&result, bytes, sizeof(T));
+        return result;
+    }
+};
+
+// Checks that PayloadBuilder stores `value` as its plain bytes in the byte
+// order recorded in `layout`.
+template <typename T>
+static bool scalar_matches(const ParamLayout &layout, T value) {
+    const byte_vector encoded = PayloadBuilder(0).add_param(value).build().parameters;
+    return encoded.size() == layout.prefix_size + sizeof(T) &&
+           layout.decode_length(encoded.data()) == sizeof(T) &&
+           layout.decode_scalar<T>(encoded.data() + layout.prefix_size) == value;
+}
+
+static bool measure_direct_scalars(ParamLayout &layout) {
+    for (bool big_endian : {false, true}) {
+        layout.scalars_big_endian = big_endian;
+        if (scalar_matches<int32_t>(layout, 0x01020304) && scalar_matches<int8_t>(layout, -7) &&
+            scalar_matches<int16_t>(layout, -0x1234) && scalar_matches<int64_t>(layout, -0x0102030405060708) &&
+            scalar_matches<uint64_t>(layout, 0xF102030405060708ULL) && scalar_matches<float>(layout, 1.5f) &&
+            scalar_matches<double>(layout, -2.25) && scalar_matches<bool>(layout, true) &&
+            scalar_matches<bool>(layout, false)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static std::optional<ParamLayout> measure_param_layout() {
+    const byte_vector small = {0xA5, 0x5A, 0xC3};
+    const byte_vector large(300, 0x7E);
+    const byte_vector encoded_small = PayloadBuilder(0).add_param(small).build().parameters;
+    const byte_vector encoded_large = PayloadBuilder(0).add_param(large).build().parameters;
+    const byte_vector encoded_int = PayloadBuilder(0).add_param(static_cast<int32_t>(7)).build().parameters;
+
+    if (encoded_small.size() <= small.size()) {
+        return std::nullopt;
+    }
+    ParamLayout layout;
+    layout.prefix_size = encoded_small.size() - small.size();
+    if (layout.prefix_size > sizeof(size_t) || encoded_large.size() != layout.prefix_size + large.size() ||
+        encoded_int.size() != layout.prefix_size + sizeof(int32_t) ||
+        !std::equal(small.begin(), small.end(), encoded_small.begin() + layout.prefix_size) ||
+        !std::equal(large.begin(), large.end(), encoded_large.begin() + layout.prefix_size)) {
+        return std::nullopt;
+    }
+    for (bool big_endian : {false, true}) {
+        layout.big_endian = big_endian;
+        if (layout.decode_length(encoded_small.data()) == small.size() &&
+            layout.decode_length(encoded_large.data()) == large.size()) {
+            layout.direct_scalars = measure_direct_scalars(layout);
+            return layout;
+        }
+    }
+    return std::nullopt;
+}
+
+static const std::optional<ParamLayout> &param_layout() {
+    static const std::optional<ParamLayout> layout = measure_param_layout();
+    return layout;
+}
+
+// A read cursor over the parameters of an existing Python Payload object.
+// Strings and bytes are built straight from the payload's buffer, and
+// read_bytes_view() returns a memoryview into it, so a large blob is not
+// copied again after the payload has been received. The view keeps the
+// payload alive, and its parameters cannot be reassigned from Python.
+class PayloadView {
+public:
+    explicit PayloadView(py::object payload)
+        : owner_(std::move(payload)), payload_(&owner_.cast<const Payload&>()) {
+        if (!param_layout()) {
+            throw std::runtime_error("PayloadView does not support the parameter encoding of this ObscuraProto build");
+        }
+    }
+
+    const Payload &payload() const { return *payload_; }
+    Payload::OpCode op_code() const { return payload_->op_code; }
+    py::memoryview data() const { return py::memoryview(owner_); }
+
+    bool has_more() const { return offset_ < payload_->parameters.size(); }
+    size_t peek_next_param_size() const { return next().second; }
+
+    py::str read_string() {
+        auto [start, size] = take();
+        return py::str(reinterpret_cast<const char*>(payload_->parameters.data() + start), size);
+    }
+
+    py::bytes read_bytes() {
+        auto [start, size] = take();
+        return py::bytes(reinterpret_cast<const char*>(payload_->parameters.data() + start), size);
+    }
+
+    py::object read_bytes_view() {
+        auto [start, size] = take();
+        return data()[py::slice(static_cast<py::ssize_t>(start), static_cast<py::ssize_t>(start + size), 1)];
+    }
+
+    py::object read_array(ParamType type) {
+        const ArrayFormat &format = checked_array_format(type);
+        return decode_array(read_bytes_view(), format);
+    }
+
+    // Scalars are decoded straight from the payload buffer using the layout
+    // measured from PayloadBuilder. If the C++ library encodes them in a way
+    // that measurement did not recognise, they are decoded through a
+    // one-parameter PayloadReader instead, which is slower but always agrees.
+    int64_t read_int() {
+        if (!param_layout()->direct_scalars) {
+            return read_through_reader(read_signed);
+        }
+        return read_direct([](const ParamLayout &layout, const uint8_t *value, size_t size) -> int64_t {
+            switch (size) {
+                case 1:
+                    return layout.decode_scalar<int8_t>(value);
+                case 2:
+                    return layout.decode_scalar<int16_t>(value);
+                case 4:
+                    return layout.decode_scalar<int32_t>(value);
+                case 8:
+                    return layout.decode_scalar<int64_t>(value);
+                default:
+                    throw std::runtime_error("Invalid size for a signed integer parameter: " + std::to_string(size));
+            }
+        });
+    }
+
+    uint64_t read_uint() {
+        if (!param_layout()->direct_scalars) {
+            return read_through_reader(read_unsigned);
+        }
+        return read_direct([](const ParamLayout &layout, const uint8_t *value, size_t size) -> uint64_t {
+            switch (size) {
+                case 1:
+                    return layout.decode_scalar<uint8_t>(value);
+                case 2:
+                    return layout.decode_scalar<uint16_t>(value);
+                case 4:
+                    return layout.decode_scalar<uint32_t>(value);
+                case 8:
+                    return layout.decode_scalar<uint64_t>(value);
+                default:
+                    throw std::runtime_error("Invalid size for an unsigned integer parameter: " + std::to_string(size));
+            }
+        });
+    }
+
+    double read_float() {
+        if (!param_layout()->direct_scalars) {
+            return read_through_reader(read_floating);
+        }
+        return read_direct([](const ParamLayout &layout, const uint8_t *value, size_t size) -> double {
+            switch (size) {
+                case 4:
+                    return layout.decode_scalar<float>(value);
+                case 8:
+                    return layout.decode_scalar<double>(value);
+                default:
+                    throw std::runtime_error("Invalid size for a float/double parameter: " + std::to_string(size));
+            }
+        });
+    }
+
+    bool read_bool() {
+        if (!param_layout()->direct_scalars) {
+            return read_through_reader([](PayloadReader &reader) { return reader.read_param<bool>(); });
+        }
+        return read_direct([](const ParamLayout &, const uint8_t *value, size_t size) {
+            if (size != 1) {
+                throw std::runtime_error("Invalid size for a boolean parameter: " + std::to_string(size));
+            }
+            return value[0] != 0;
+        });
+    }
+
+private:
+    // (start, size) of the next value inside the parameters buffer.
+    std::pair<size_t, size_t> next() const {
+        const ParamLayout &layout = *param_layout();
+        const byte_vector &params = payload_->parameters;
+        if (params.size() - offset_ < layout.prefix_size) {
+            throw std::out_of_range("No more parameters to read");
+        }
+        size_t start = offset_ + layout.prefix_size;
+        size_t size = layout.decode_length(params.data() + offset_);
+        if (params.size() - start < size) {
+            throw std::out_of_range("Parameter size exceeds the payload");
+        }
+        return {start, size};
+    }
+
+    std::pair<size_t, size_t> take() {
+        auto span = next();
+        offset_ = span.first + span.second;
+        return span;
+    }
+
+    // Decodes the next value in place; the cursor only advances on success.
+    template <typename Decode>
+    auto read_direct(Decode decode) {
+        auto [start, size] = next();
+        auto value = decode(*param_layout(), payload_->parameters.data() + start, size);
+        offset_ = start + size;
+        return value;
+    }
+
+    template <typename Read>
+    auto read_through_reader(Read read) {
+        auto [start, size] = next();
+        Payload single;
+        single.parameters.assign(payload_->parameters.begin() + offset_, payload_->parameters.begin() + start + size);
+        PayloadReader reader(single);
+        auto value = read(reader);
+        offset_ = start + size;
+        return value;
+    }
+
+    py::object owner_;
+    const Payload *payload_;
+    size_t offset_ = 0;
+};
+
+static py::object read_typed_param(PayloadView &view, ParamType type) {
+    switch (type) {
+        case ParamType::STRING:
+            return view.read_string();
+        case ParamType::INT:
+            return py::int_(view.read_int());
+        case ParamType::UINT:
+            return py::int_(view.read_uint());
+        case ParamType::FLOAT:
+            return py::float_(view.read_float());
+        case ParamType::BOOL:
+            return py::bool_(view.read_bool());
+        case ParamType::BYTES:
+            return view.read_bytes();
+        case ParamType::BYTES_VIEW:
+            return view.read_bytes_view();
+        case ParamType::INT32_ARRAY:
+        case ParamType::INT64_ARRAY:
+        case ParamType::FLOAT32_ARRAY:
+        case ParamType::FLOAT64_ARRAY:
+            return view.read_array(type);
+    }
+    throw std::runtime_error("Unknown parameter type in payload schema");
+}
+
+static py::tuple read_all_view(PayloadView &view, const PayloadSchema &schema) {
+    py::tuple values(schema.types.size());
+    for (size_t i = 0; i < schema.types.size(); ++i) {
+        values[i] = read_typed_param(view, schema.types[i]);
+    }
+    return values;
+}
+
+// The schema, not the value, decides the encoding. add_param() takes the first
+// pybind11 overload that accepts the value, so 200 becomes a uint8_t and 1.5 a
+// float. Here INT values use the narrowest signed width that holds them, UINT
+// values the narrowest unsigned width, and FLOAT values are always doubles, so
+// read_int() / read_uint() / read_float() return what was written.
+static void add_typed_param(PayloadBuilder &builder, ParamType type, const py::handle &value) {
+    switch (type) {
+        case ParamType::STRING:
+            builder.add_param(value.cast<std::string>());
+            return;
+        case ParamType::INT: {
+            auto v = value.cast<int64_t>();
+            if (v >= std::numeric_limits<int8_t>::min() && v <= std::numeric_limits<int8_t>::max()) {
+                builder.add_param(static_cast<int8_t>(v));
+            } else if (v >= std::numeric_limits<int16_t>::min() && v <= std::numeric_limits<int16_t>::max()) {
+                builder.add_param(static_cast<int16_t>(v));
+            } else if (v >= std::numeric_limits<int32_t>::min() && v <= std::numeric_limits<int32_t>::max()) {
+                builder.add_param(static_cast<int32_t>(v));
+            } else {
+                builder.add_param(v);
+            }
+            return;
+        }
+        case ParamType::UINT: {
+            auto v = value.cast<uint64_t>();
+            if (v <= std::numeric_limits<uint8_t>::max()) {
+                builder.add_param(static_cast<uint8_t>(v));
+            } else if (v <= std::numeric_limits<uint16_t>::max()) {
+                builder.add_param(static_cast<uint16_t>(v));
+            } else if (v <= std::numeric_limits<uint32_t>::max()) {
+                builder.add_param(static_cast<uint32_t>(v));
+            } else {
+                builder.add_param(v);
+            }
+            return;
+        }
+        case ParamType::FLOAT:
+            builder.add_param(value.cast<double>());
+            return;
+        case ParamType::BOOL:
+            builder.add_param(value.cast<bool>());
+            return;
+        case ParamType::BYTES:
+        case ParamType::BYTES_VIEW:
+            builder.add_param(ContiguousBuffer(value).to_vector());
+            return;
+        case ParamType::INT32_ARRAY:
+        case ParamType::INT64_ARRAY:
+        case ParamType::FLOAT32_ARRAY:
+        case ParamType::FLOAT64_ARRAY:
+            builder.add_param(encode_array(value, *array_format(type)));
+            return;
+    }
+    throw std::runtime_error("Unknown parameter type in payload schema");
+}
+
+static Payload build_from(Payload::OpCode op_code, const py::sequence &values, const PayloadSchema &schema) {
+    if (values.size() != schema.types.size()) {
+        throw py::value_error("Expected " + std::to_string(schema.types.size()) + " values for the payload schema, got " +
+                              std::to_string(values.size()));
+    }
+    PayloadBuilder builder(op_code);
+    for (size_t i = 0; i < schema.types.size(); ++i) {
+        py::object value = values[i];
+        try {
+            add_typed_param(builder, schema.types[i], value);
+        } catch (const py::cast_error &) {
+            throw py::type_error("Value at index " + std::to_string(i) + " does not match its payload schema type");
+        }
+    }
+    return builder.build();
+}
+
+
+// Writes [data, data + size) as chunk_size-sized STREAM_DATA frames. Called
+// with the GIL released; the caller keeps the source buffer alive.
+static void write_chunked(Stream &stream, const uint8_t *data, size_t size, size_t chunk_size) {
+    for (size_t offset = 0; offset < size; offset += chunk_size) {
+        size_t length = std::min(chunk_size, size - offset);
+        stream.write(byte_vector(data + offset, data + offset + length));
+    }
+}
+
+// Default write_large / send_file chunk size. It leaves headroom for the frame
+// header under the default max_decrypted_payload of 65535 bytes.
+static constexpr size_t DEFAULT_CHUNK_SIZE = 16384;
+
+static size_t checked_chunk_size(size_t chunk_size) {
+    if (chunk_size == 0) {
+        throw py::value_error("chunk_size must be at least 1");
+    }
+    return chunk_size;
+}
+
+// Streams a file in chunk_size frames, reading one chunk at a time so memory
+// use does not grow with the file. Returns the number of bytes sent.
+static size_t send_file(Stream &stream, const std::string &path, size_t chunk_size) {
+    checked_chunk_size(chunk_size);
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Cannot open file for streaming: " + path);
+    }
+    py::gil_scoped_release release;
+    byte_vector chunk(chunk_size);
+    size_t total = 0;
+    while (file) {
+        file.read(reinterpret_cast<char*>(chunk.data()), static_cast<std::streamsize>(chunk_size));
+        auto length = static_cast<size_t>(file.gcount());
+        if (length == 0) {
+            break;
+        }
+        chunk.resize(length);
+        stream.write(chunk);
+        total += length;
+    }
+    if (file.bad()) {
+        throw std::runtime_error("Error while reading file for streaming: " + path);
+    }
+    return total;
+}
+
+// Replaces the data and end handlers so incoming chunks are appended to one
+// native buffer on the I/O thread, and the callback receives the whole
+// message as bytes when the remote side ends the stream. A peer sending more
+// than max_size bytes gets the stream cancelled, the buffer is freed and the
+// callback is never called, so reassembly cannot be used to exhaust memory.
+static void set_collect_handler(const std::shared_ptr<Stream> &stream, std::function<void(py::bytes)> callback,
+                                size_t max_size) {
+    if (max_size == 0) {
+        throw py::value_error("max_size must be greater than zero");
+    }
+    struct State {
+        byte_vector buffer;
+        bool overflowed = false;
+    };
+    auto state = std::make_shared<State>();
+    std::weak_ptr<Stream> weak_stream = stream;
+    stream->set_data_handler([state, weak_stream, max_size](const byte_vector &data) {
+        if (state->overflowed) {
+            return;
+        }
+        if (data.size() > max_size - state->buffer.size()) {
+            state->overflowed = true;
+            byte_vector().swap(state->buffer);
+            if (auto stream = weak_stream.lock()) {
+                stream->cancel();
+            }
+            return;
+        }
+        state->buffer.insert(state->buffer.end(), data.begin(), data.end());
+    });
+    stream->set_end_handler([state, callback]() {
+        if (state->overflowed) {
+            return;
+        }
+        py::gil_scoped_acquire gil;
+        py::bytes message(reinterpret_cast<const char*>(state->buffer.data()), state->buffer.size());
+        byte_vector().swap(state->buffer);
+        callback(message);
+    });
+}
+
+
+// A Python callable invoked directly from native handler lambdas, without the
+// std::function that pybind11's functional caster would wrap it in. Handlers
+// capture it by shared_ptr, so the C++ library may copy them without holding
+// the GIL; the callable is released under the GIL with its last copy.
+class PyCallback {
+public:
+    explicit PyCallback(py::function fn)
+        : fn_(new py::function(std::move(fn)), [](py::function *f) {
+              py::gil_scoped_acquire gil;
+              delete f;
+          }) {}
+
+    template <typename Result = void, typename... Args>
+    Result call(Args &&...args) const {
+        py::gil_scoped_acquire gil;
+        py::object result = (*fn_)(std::forward<Args>(args)...);
+        if constexpr (!std::is_void_v<Result>) {
+            return result.cast<Result>();
+        }
+    }
+
+private:
+    std::shared_ptr<py::function> fn_;
+};
+
+// Log2-bucketed latency histogram in microseconds. Recording is a handful of
+// relaxed atomic operations, so any thread may record without a lock.
+// Percentiles are reported as the upper bound of the bucket they fall in.
+class LatencyHistogram {
+public:
+    void record(std::chrono::steady_clock::duration elapsed) {
+        auto us = static_cast<uint64_t>(std::max<int64_t>(
+            0, std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()));
+        size_t bucket = 0;
+        while (bucket + 1 < kBuckets && (uint64_t{1} << bucket) <= us) {
+            ++bucket;
+        }
+        buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        total_us_.fetch_add(us, std::memory_order_relaxed);
+        uint64_t max = max_us_.load(std::memory_order_relaxed);
+        while (us > max && !max_us_.compare_exchange_weak(max, us, std::memory_order_relaxed)) {
+        }
+    }
+
+    py::dict to_dict() const {
+        uint64_t count = count_.load(std::memory_order_relaxed);
+        py::dict result;
+        result["count"] = count;
+        result["sum_us"] = total_us_.load(std::memory_order_relaxed);
+        result["mean_us"] = count ? static_cast<double>(total_us_.load(std::memory_order_relaxed)) / count : 0.0;
+        result["max_us"] = max_us_.load(std::memory_order_relaxed);
+        result["p50_us"] = percentile(count, 0.50);
+        result["p90_us"] = percentile(count, 0.90);
+        result["p99_us"] = percentile(count, 0.99);
+        return result;
+    }
+
+private:
+    static constexpr size_t kBuckets = 40;
+
+    uint64_t percentile(uint64_t count, double q) const {
+        if (count == 0) {
+            return 0;
+        }
+        auto rank = static_cast<uint64_t>(q * static_cast<double>(count - 1)) + 1;
+        uint64_t seen = 0;
+        for (size_t bucket = 0; bucket < kBuckets; ++bucket) {
+            seen += buckets_[bucket].load(std::memory_order_relaxed);
+            if (seen >= rank) {
+                return uint64_t{1} << bucket;
+            }
+        }
+        return max_us_.load(std::memory_order_relaxed);
+    }
+
+    std::array<std::atomic<uint64_t>, kBuckets> buckets_{};
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> total_us_{0};
+    std::atomic<uint64_t> max_us_{0};
+};
+
+struct TrafficCounters {
+    std::atomic<uint64_t> messages{0};
+    std::atomic<uint64_t> bytes{0};
+
+    void add(size_t payload_bytes, uint64_t count = 1) {
+        messages.fetch_add(count, std::memory_order_relaxed);
+        bytes.fetch_add(payload_bytes * count, std::memory_order_relaxed);
+    }
+    void add(const Payload &payload, uint64_t count = 1) { add(payload.parameters.size(), count); }
+
+    py::dict to_dict() const {
+        py::dict result;
+        result["messages"] = messages.load(std::memory_order_relaxed);
+        result["bytes"] = bytes.load(std::memory_order_relaxed);
+        return result;
+    }
+};
+
+struct OpcodeMetrics {
+    TrafficCounters received;
+    LatencyHistogram handler_us;
+};
+
+// Traffic seen by one WsServer / WsClient through the bindings: payloads
+// delivered to registered handlers, payloads sent, and request round trips.
+// Byte counts are payload parameter sizes. Opcode entries are created when a
+// handler is registered, so the hot path never touches the map.
+class BindingMetrics {
+public:
+    TrafficCounters received;
+    TrafficCounters sent;
+    LatencyHistogram request_rtt;
+
+    std::shared_ptr<OpcodeMetrics> opcode(Payload::OpCode op_code) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto &entry = opcodes_[op_code];
+        if (!entry) {
+            entry = std::make_shared<OpcodeMetrics>();
+        }
+        return entry;
+    }
+
+    py::dict to_dict() const {
+        py::dict opcodes;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (const auto &[op_code, entry] : opcodes_) {
+                py::dict stats = entry->received.to_dict();
+                stats["handler_us"] = entry->handler_us.to_dict();
+                opcodes[py::int_(op_code)] = std::move(stats);
+            }
+        }
+        py::dict result;
+        result["received"] = received.to_dict();
+        result["sent"] = sent.to_dict();
+        result["request_rtt_us"] = request_rtt.to_dict();
+        result["opcodes"] = std::move(opcodes);
+        return result;
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::map<Payload::OpCode, std::shared_ptr<OpcodeMetrics>> opcodes_;
+};
+
+// WsServer / WsClient as bound to Python: the library wrapper plus the
+// metrics for traffic through the bindings, created and freed with it.
+struct BoundWsServer : WsServerWrapper {
+    using WsServerWrapper::WsServerWrapper;
+    std::shared_ptr<BindingMetrics> metrics = std::make_shared<BindingMetrics>();
+};
+
+struct BoundWsClient : WsClientWrapper {
+    using WsClientWrapper::WsClientWrapper;
+    std::shared_ptr<BindingMetrics> metrics = std::make_shared<BindingMetrics>();
+};
+
+// Records the time until the end of the scope, including when it is left by
+// an exception.
+class ScopedTimer {
+public:
+    explicit ScopedTimer(LatencyHistogram &histogram)
+        : histogram_(histogram), start_(std::chrono::steady_clock::now()) {}
+    ~ScopedTimer() { histogram_.record(std::chrono::steady_clock::now() - start_); }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    LatencyHistogram &histogram_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+// Runs a blocking request and records its round trip and traffic.
+template <typename Request>
+static Payload timed_request(BindingMetrics &metrics, const Payload &payload, Request request) {
+    Payload response;
+    {
+        ScopedTimer timer(metrics.request_rtt);
+        response = request();
+    }
+    metrics.sent.add(payload);
+    metrics.received.add(response);
+    return response;
+}
+
+// Adapt a Python callable to the native handler signatures, counting each
+// dispatch. Payloads are moved into their Python objects rather than copied.
+// `opcode` is null for default handlers, which are only counted in the totals.
+static std::function<void(WsConnectionHdl, Payload)> make_payload_handler(
+    py::function fn, std::shared_ptr<BindingMetrics> metrics, std::shared_ptr<OpcodeMetrics> opcode = nullptr) {
+    return [callback = PyCallback(std::move(fn)), metrics, opcode](WsConnectionHdl hdl, Payload payload) {
+        metrics->received.add(payload);
+        if (!opcode) {
+            callback.call(WsConnectionHdlWrapper{hdl}, std::move(payload));
+            return;
+        }
+        opcode->received.add(payload);
+        ScopedTimer timer(opcode->handler_us);
+        callback.call(WsConnectionHdlWrapper{hdl}, std::move(payload));
+    };
+}
+
+static std::function<void(Payload)> make_client_payload_handler(
+    py::function fn, std::shared_ptr<BindingMetrics> metrics, std::shared_ptr<OpcodeMetrics> opcode = nullptr) {
+    return [callback = PyCallback(std::move(fn)), metrics, opcode](Payload payload) {
+        metrics->received.add(payload);
+        if (!opcode) {
+            callback.call(std::move(payload));
+            return;
+        }
+        opcode->received.add(payload);
+        ScopedTimer timer(opcode->handler_us);
+        callback.call(std::move(payload));
+    };
+}
+
+// Request handlers only see a PayloadReader, so incoming requests are counted
+// as messages without bytes; the response is counted as sent.
+static std::function<Payload(WsConnectionHdl, PayloadReader&)> make_request_handler(
+    py::function fn, std::shared_ptr<BindingMetrics> metrics, std::shared_ptr<OpcodeMetrics> opcode) {
+    return [callback = PyCallback(std::move(fn)), metrics, opcode](WsConnectionHdl hdl, PayloadReader &reader) {
+        metrics->received.add(0);
+        opcode->received.add(0);
+        Payload response;
+        {
+            ScopedTimer timer(opcode->handler_us);
+            response = callback.call<Payload>(WsConnectionHdlWrapper{hdl}, reader);
+        }
+        metrics->sent.add(response);
+        return response;
+    };
+}
+
+static std::function<Payload(PayloadReader&)> make_client_request_handler(
+    py::function fn, std::shared_ptr<BindingMetrics> metrics, std::shared_ptr<OpcodeMetrics> opcode) {
+    return [callback = PyCallback(std::move(fn)), metrics, opcode](PayloadReader &reader) {
+        metrics->received.add(0);
+        opcode->received.add(0);
+        Payload response;
+        {
+            ScopedTimer timer(opcode->handler_us);
+            response = callback.call<Payload>(reader);
+        }
+        metrics->sent.add(response);
+        return response;
+    };
+}
+
+
+// Payloads queued by a batched op handler: with the sender's handle on the
+// server, bare payloads on the client.
+using HdlPayload = std::pair<WsConnectionHdl, Payload>;
+
+static py::object batch_item_to_python(HdlPayload &item) {
+    return py::make_tuple(WsConnectionHdlWrapper{item.first}, std::move(item.second));
+}
+
+static py::object batch_item_to_python(Payload &item) {
+    return py::cast(std::move(item));
+}
+
+// Collects payloads delivered on the WebSocket thread and hands them to a
+// Python callback as one list, so the GIL is taken once per batch rather than
+// once per message. A batch is flushed as soon as it holds max_batch items or
+// when its oldest item has waited max_delay. The I/O thread only holds the
+// queue mutex long enough to append.
+template <typename Item>
+class PayloadBatcher {
+public:
+    PayloadBatcher(std::function<void(py::list)> callback, size_t max_batch, std::chrono::microseconds max_delay)
+        : callback_(std::move(callback)), max_batch_(max_batch), max_delay_(max_delay),
+          worker_([this] { run(); }) {}
+
+    ~PayloadBatcher() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        // The worker may be waiting for the GIL to deliver a last batch.
+        if (PyGILState_Check()) {
+            py::gil_scoped_release release;
+            worker_.join();
+        } else {
+            worker_.join();
+        }
+    }
+
+    PayloadBatcher(const PayloadBatcher&) = delete;
+    PayloadBatcher& operator=(const PayloadBatcher&) = delete;
+
+    void push(Item item) {
+        bool wake;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            queue_.push_back(std::move(item));
+            enqueued_.push_back(std::chrono::steady_clock::now());
+            wake = queue_.size() == 1 || queue_.size() >= max_batch_;
+        }
+        if (wake) {
+            cv_.notify_one();
+        }
+    }
+
+private:
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            cv_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+            if (!stopping_) {
+                cv_.wait_until(lock, enqueued_.front() + max_delay_,
+                               [this] { return stopping_ || queue_.size() >= max_batch_; });
+            }
+            if (queue_.empty()) {
+                return;  // Stopping with nothing left to deliver.
+            }
+
+            std::vector<Item> batch;
+            if (queue_.size() <= max_batch_) {
+                batch.swap(queue_);
+                enqueued_.clear();
+            } else {
+                // The remainder keeps its own enqueue times, so its deadline
+                // still counts from when its oldest item arrived.
+                auto split = queue_.begin() + static_cast<std::ptrdiff_t>(max_batch_);
+                batch.assign(std::make_move_iterator(queue_.begin()), std::make_move_iterator(split));
+                queue_.erase(queue_.begin(), split);
+                enqueued_.erase(enqueued_.begin(), enqueued_.begin() + static_cast<std::ptrdiff_t>(max_batch_));
+            }
+            lock.unlock();
+            deliver(batch);
+            lock.lock();
+        }
+    }
+
+    void deliver(std::vector<Item> &batch) {
+        py::gil_scoped_acquire gil;
+        try {
+            py::list items(batch.size());
+            for (size_t i = 0; i < batch.size(); ++i) {
+                items[i] = batch_item_to_python(batch[i]);
+            }
+            callback_(std::move(items));
+        } catch (py::error_already_set &e) {
+            e.discard_as_unraisable("ObscuraProto batched op handler");
+        }
+    }
+
+    std::function<void(py::list)> callback_;
+    const size_t max_batch_;
+    const std::chrono::microseconds max_delay_;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::vector<Item> queue_;
+    std::deque<std::chrono::steady_clock::time_point> enqueued_;  // One per queue_ entry.
+    bool stopping_ = false;
+
+    // Declared last so every member above is initialized before the worker starts.
+    std::thread worker_;
+};
+
+template <typename Item>
+static std::shared_ptr<PayloadBatcher<Item>> make_batcher(std::function<void(py::list)> callback,
+                                                         size_t max_batch, uint64_t max_delay_us) {
+    if (max_batch == 0) {
+        throw py::value_error("max_batch must be at least 1");
+    }
+    return std::make_shared<PayloadBatcher<Item>>(std::move(callback), max_batch,
+                                                  std::chrono::microseconds(max_delay_us));
+}
+
+// Native threads that run blocking sync_request calls for request_async and
+// timed sync_request. The pool grows on demand up to max_threads and is shared
+// by every server and client, so a burst of async requests queues instead of
+// starting one OS thread per request; threads idle for a minute exit.
+//
+// Each task holds a reference to the Python wrapper whose C++ object its
+// request uses, and releases it under the GIL only after the request has
+// returned, so a captured WsServerWrapper& / WsClientWrapper& cannot dangle.
+// At interpreter exit shutdown() drops queued tasks and waits for completions
+// in progress. Workers still blocked inside the C++ library are detached and
+// never touch Python again; their references are leaked rather than released
+// without the GIL.
+class RequestPool {
+public:
+    // Called with the GIL held: the response, or an error message.
+    using Complete = std::function<void(std::optional<Payload>, std::string)>;
+
+    static RequestPool &instance() {
+        // Never destroyed: detached workers may still use it after exit.
+        static RequestPool *pool = new RequestPool();
+        return *pool;
+    }
+
+    void set_max_threads(size_t max_threads) {
+        if (max_threads == 0) {
+            throw py::value_error("max_threads must be at least 1");
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        max_threads_ = max_threads;
+    }
+
+    size_t max_threads() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return max_threads_;
+    }
+
+    // Queues a request. A task whose `abandoned` flag is set before a worker
+    // picks it up is dropped without running. Must be called with the GIL held.
+    void submit(py::object owner, std::function<Payload()> request, Complete complete,
+                std::shared_ptr<std::atomic<bool>> abandoned = nullptr) {
+        auto task = std::make_unique<Task>();
+        task->owner = std::move(owner);
+        task->request = std::move(request);
+        task->complete = std::move(complete);
+        task->abandoned = std::move(abandoned);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_) {
+            throw std::runtime_error("ObscuraProto request pool has been shut down");
+        }
+        queue_.push_back(std::move(task));
+        if (idle_ < queue_.size() && workers_.size() < max_threads_) {
+            workers_.emplace_back();
+            Worker *worker = &workers_.back();
+            worker->thread = std::thread([this, worker] { run(worker); });
+        }
+        cv_.notify_one();
+    }
+
+    // Called from atexit with the GIL held.
+    void shutdown() {
+        std::deque<std::unique_ptr<Task>> pending;
+        std::vector<std::thread> idle_threads;
+        {
+            py::gil_scoped_release release;
+            std::unique_lock<std::mutex> lock(mutex_);
+            stopping_ = true;
+            pending.swap(queue_);
+            cv_.notify_all();
+            // Completions in progress need the GIL, which is released here.
+            completed_cv_.wait(lock, [this] { return completing_ == 0; });
+            for (auto &worker : workers_) {
+                if (worker.busy) {
+                    worker.thread.detach();
+                } else {
+                    idle_threads.push_back(std::move(worker.thread));
+                }
+            }
+            workers_.clear();
+            lock.unlock();
+            for (auto &thread : idle_threads) {
+                thread.join();
+            }
+        }
+        // `pending` never ran; its Python references are released here, under the GIL.
+    }
+
+private:
+    struct Task {
+        py::object owner;
+        std::function<Payload()> request;
+        Complete complete;
+        std::shared_ptr<std::atomic<bool>> abandoned;
+    };
+
+    struct Worker {
+        std::thread thread;
+        bool busy = false;
+    };
+
+    RequestPool() = default;
+
+    void run(Worker *worker) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            ++idle_;
+            bool woken = cv_.wait_for(lock, std::chrono::seconds(60), [this] { return stopping_ || !queue_.empty(); });
+            --idle_;
+            if (stopping_) {
+                return;
+            }
+            if (!woken) {
+                // Idle for a minute: retire this thread.
+                for (auto it = workers_.begin(); it != workers_.end(); ++it) {
+                    if (&*it == worker) {
+                        it->thread.detach();
+                        workers_.erase(it);
+                        break;
+                    }
+                }
+                return;
+            }
+            std::unique_ptr<Task> task = std::move(queue_.front());
+            queue_.pop_front();
+            worker->busy = true;
+            lock.unlock();
+
+            std::optional<Payload> response;
+            std::string error;
+            bool skipped = task->abandoned && task->abandoned->load();
+            if (!skipped) {
+                try {
+                    response = task->request();
+                } catch (const std::exception &e) {
+                    error = e.what();
+                    if (error.empty()) {
+                        error = "Request failed";
+                    }
+                }
+            }
+
+            lock.lock();
+            if (stopping_) {
+                // The interpreter is exiting; leave Python alone.
+                task.release();
+                return;
+            }
+            ++completing_;
+            lock.unlock();
+            {
+                py::gil_scoped_acquire gil;
+                if (!skipped) {
+                    try {
+                        task->complete(std::move(response), std::move(error));
+                    } catch (py::error_already_set &e) {
+                        e.discard_as_unraisable("ObscuraProto async request completion");
+                    }
+                }
+                // Release the callbacks first and the owner last, all under the GIL.
+                task->complete = nullptr;
+                task->request = nullptr;
+                task.reset();
+            }
+            lock.lock();
+            --completing_;
+            if (stopping_) {
+                completed_cv_.notify_all();
+                return;
+            }
+            worker->busy = false;
+        }
+    }
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::condition_variable completed_cv_;
+    std::deque<std::unique_ptr<Task>> queue_;
+    std::list<Worker> workers_;
+    size_t max_threads_ = 64;
+    size_t idle_ = 0;
+    size_t completing_ = 0;
+    bool stopping_ = false;
+};
+
+// Returned by the *_async request methods. cancel() drops the request if no
+// pool thread has started it yet; once it is running, the library cannot stop
+// it and on_done is still called.
+struct PendingRequest {
+    std::shared_ptr<std::atomic<bool>> abandoned = std::make_shared<std::atomic<bool>>(false);
+
+    void cancel() { abandoned->store(true); }
+};
+
+// Runs a blocking sync_request on the shared RequestPool, so Python callers do
+// not tie up an executor thread per in-flight request. The outcome is reported
+// as on_done(response, error), with exactly one of the two set to None.
+// `owner` is the Python wrapper of the server/client and keeps it alive until
+// the request has completed.
+static PendingRequest run_request_async(py::object owner, std::function<Payload()> request,
+                                        std::function<void(py::object, py::object)> on_done) {
+    PendingRequest pending;
+    RequestPool::instance().submit(std::move(owner), std::move(request),
+        [on_done = std::move(on_done)](std::optional<Payload> response, std::string error) {
+            if (response) {
+                on_done(py::cast(std::move(*response)), py::none());
+            } else {
+                on_done(py::none(), py::reinterpret_borrow<py::object>(PyExc_RuntimeError)(error));
+            }
+        }, pending.abandoned);
+    return pending;
+}
+
+// Runs a blocking request on the RequestPool with a deadline. The C++
+// library's sync_request cannot be cancelled: on timeout the caller gets
+// TimeoutError, a request still queued is dropped, and one already running
+// keeps its pool thread until the library returns, after which its response
+// is discarded. Timed-out requests therefore count against the pool's
+// max_threads and cannot pile up threads beyond it.
+static Payload request_with_timeout(py::object owner, std::function<Payload()> request, double timeout_s) {
+    if (!(timeout_s > 0)) {
+        throw py::value_error("timeout must be a positive number of seconds");
+    }
+    struct State {
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool done = false;
+        std::optional<Payload> response;
+        std::string error;
+    };
+    auto state = std::make_shared<State>();
+    auto abandoned = std::make_shared<std::atomic<bool>>(false);
+    RequestPool::instance().submit(std::move(owner), std::move(request),
+        [state](std::optional<Payload> response, std::string error) {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->response = std::move(response);
+            state->error = std::move(error);
+            state->done = true;
+            state->cv.notify_all();
+        }, abandoned);
+
+    bool done;
+    {
+        py::gil_scoped_release release;
+        std::unique_lock<std::mutex> lock(state->mutex);
+        done = state->cv.wait_for(lock, std::chrono::duration<double>(timeout_s), [&] { return state->done; });
+        if (!done) {
+            abandoned->store(true);
+        }
+    }
+    if (!done) {
+        PyErr_SetString(PyExc_TimeoutError, "Request timed out");
+        throw py::error_already_set();
+    }
+    if (!state->response) {
+        throw std::runtime_error(state->error);
+    }
+    return std::move(*state->response);
+}
+
+// Runs request(i) for every i in [0, count) with at most `window` requests in
+// flight. Each worker thread takes the next index as soon as its previous
+// request completes, so one slow round trip does not hold back the ones queued
+// behind it. No new requests are started after the first failure, and that
+// error is rethrown once the in-flight ones have finished. Responses are
+// returned in index order. The window is capped at the RequestPool limit, so
+// max_request_threads() bounds these threads too. Must be called with the GIL
+// released.
+static std::vector<Payload> pipeline_requests(size_t count, size_t window,
+                                              const std::function<Payload(size_t)> &request) {
+    if (window == 0) {
+        throw py::value_error("max_in_flight must be at least 1");
+    }
+    window = std::min(window, RequestPool::instance().max_threads());
+    std::vector<Payload> responses(count);
+    std::atomic<size_t> next{0};
+    std::atomic<bool> failed{false};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    auto worker = [&] {
+        for (size_t i = next++; i < count && !failed; i = next++) {
+            try {
+                responses[i] = request(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+                failed = true;
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    try {
+        for (size_t t = 1; t < std::min(window, count); ++t) {
+            workers.emplace_back(worker);
+        }
+    } catch (const std::system_error &) {
+        // Out of threads: carry on with the ones already started. The calling
+        // thread always takes part, so every request still runs.
+    }
+    worker();
+    for (auto &thread : workers) {
+        thread.join();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    return responses;
+}
+
+// Calls fn(i) for every i in [0, count), splitting the range into contiguous
+// chunks across `threads` threads (the calling thread included). The first
+// exception thrown by fn is rethrown once every thread has finished.
+template <typename Fn>
+static void parallel_for(size_t count, size_t threads, Fn fn) {
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    auto run_range = [&](size_t begin, size_t end) {
+        try {
+            for (size_t i = begin; i < end; ++i) {
+                fn(i);
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+    };
+
+    threads = std::max<size_t>(1, std::min(threads, count));
+    size_t chunk = (count + threads - 1) / threads;
+    std::vector<std::thread> workers;
+    for (size_t t = 1; t < threads; ++t) {
+        workers.emplace_back(run_range, std::min(count, t * chunk), std::min(count, (t + 1) * chunk));
+    }
+    run_range(0, std::min(count, chunk));
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+// Sends one payload to many targets across `workers` threads. Sends that fail,
+// e.g. because the connection has just closed, are skipped. Returns the number
+// of targets the payload was queued for.
+template <typename Target, typename SendFn>
+static size_t fan_out(const std::vector<Target> &targets, size_t workers, SendFn send) {
+    std::atomic<size_t> sent{0};
+    parallel_for(targets.size(), workers, [&](size_t i) {
+        try {
+            send(targets[i]);
+            sent.fetch_add(1, std::memory_order_relaxed);
+        } catch (const std::exception &) {
+        }
+    });
+    return sent.load();
+}
+
+// Batch crypto calls take a list of buffers or one contiguous buffer split by
+// an offsets list ([0, end_0, end_1, ..., len]), and return the results packed
+// the same way: (bytes, offsets). The output of encrypt_batch can therefore be
+// passed straight to decrypt_batch.
+using SessionKey = decltype(Crypto::SessionKeys::tx);
+
+struct ByteSpan {
+    const uint8_t *data;
+    size_t size;
+};
+
+struct BatchInput {
+    std::vector<std::unique_ptr<ContiguousBuffer>> buffers;
+    std::vector<ByteSpan> spans;
+};
+
+static BatchInput batch_input_from_list(const py::iterable &messages) {
+    BatchInput input;
+    for (py::handle message : messages) {
+        input.buffers.push_back(std::make_unique<ContiguousBuffer>(message));
+        input.spans.push_back({input.buffers.back()->data(), input.buffers.back()->size()});
+    }
+    return input;
+}
+
+static BatchInput batch_input_from_offsets(const py::buffer &data, const std::vector<size_t> &offsets) {
+    BatchInput input;
+    input.buffers.push_back(std::make_unique<ContiguousBuffer>(data));
+    const ContiguousBuffer &buffer = *input.buffers.back();
+    if (offsets.empty() || offsets.front() != 0 || offsets.back() != buffer.size()) {
+        throw py::value_error("offsets must start at 0 and end at the length of data");
+    }
+    for (size_t i = 1; i < offsets.size(); ++i) {
+        if (offsets[i] < offsets[i - 1]) {
+            throw py::value_error("offsets must be non-decreasing");
+        }
+        input.spans.push_back({buffer.data() + offsets[i - 1], offsets[i] - offsets[i - 1]});
+    }
+    return input;
+}
+
+template <typename Transform>
+static py::tuple transform_batch(const BatchInput &input, size_t threads, Transform transform) {
+    std::vector<byte_vector> outputs(input.spans.size());
+    {
+        py::gil_scoped_release release;
+        parallel_for(input.spans.size(), threads, [&](size_t i) {
+            const ByteSpan &span = input.spans[i];
+            outputs[i] = transform(byte_vector(span.data, span.data + span.size));
+        });
+    }
+
+    std::vector<size_t> offsets(outputs.size() + 1, 0);
+    for (size_t i = 0; i < outputs.size(); ++i) {
+        offsets[i + 1] = offsets[i] + outputs[i].size();
+    }
+    py::bytes packed(nullptr, offsets.back());
+    char *out = PyBytes_AS_STRING(packed.ptr());
+    for (size_t i = 0; i < outputs.size(); ++i) {
+        std::copy(outputs[i].begin(), outputs[i].end(), out + offsets[i]);
+    }
+    return py::make_tuple(std::move(packed), offsets);
+}
+
+static py::tuple encrypt_batch(const SessionKey &key, const BatchInput &input, size_t threads) {
+    return transform_batch(input, threads, [&key](const byte_vector &message) { return Crypto::encrypt(message, key); });
+}
+
+static py::tuple decrypt_batch(const SessionKey &key, const BatchInput &input, size_t threads) {
+    return transform_batch(input, threads, [&key](const byte_vector &message) { return Crypto::decrypt(message, key); });
+}
 
 PYBIND11_MODULE(_obscuraproto, m) {
     m.doc() = "Python bindings for the ObscuraProto C++ library";
@@ -41,6 +1562,19 @@ PYBIND11_MODULE(_obscuraproto, m) {
     py::class_<VersionNegotiator>(m, "VersionNegotiator")
         .def_static("negotiate", &VersionNegotiator::negotiate);
 
+    // Native request threads
+    m.def("set_max_request_threads", [](size_t max_threads) { RequestPool::instance().set_max_threads(max_threads); },
+          py::arg("max_threads"),
+          "Sets how many native threads may run request_async and timed sync_request calls at once (default 64). "
+          "The limit is shared by every server and client in the process. Further requests queue until a thread "
+          "is free.");
+    m.def("max_request_threads", [] { return RequestPool::instance().max_threads(); },
+          "Returns the limit set by set_max_request_threads.");
+    py::class_<PendingRequest>(m, "PendingRequest")
+        .def("cancel", &PendingRequest::cancel,
+             "Drops the request if it is still queued. A request already running completes as usual.");
+    py::module_::import("atexit").attr("register")(py::cpp_function([] { RequestPool::instance().shutdown(); }));
+
     // Config
     py::class_<RateLimitConfig>(m, "RateLimitConfig")
         .def(py::init<>())
@@ -149,7 +1683,25 @@ PYBIND11_MODULE(_obscuraproto, m) {
         .def_static("client_compute_session_keys", &Crypto::client_compute_session_keys)
         .def_static("server_compute_session_keys", &Crypto::server_compute_session_keys)
         .def_static("encrypt", &Crypto::encrypt)
-        .def_static("decrypt", &Crypto::decrypt);
+        .def_static("decrypt", &Crypto::decrypt)
+        .def_static("encrypt_batch", [](const SessionKey &key, const py::iterable &messages, size_t threads) {
+            return encrypt_batch(key, batch_input_from_list(messages), threads);
+        }, py::arg("key"), py::arg("messages"), py::arg("threads") = 1,
+             "Encrypts a list of bytes-like messages with the GIL released. Returns (data, offsets).")
+        .def_static("encrypt_batch", [](const SessionKey &key, const py::buffer &data,
+                                        const std::vector<size_t> &offsets, size_t threads) {
+            return encrypt_batch(key, batch_input_from_offsets(data, offsets), threads);
+        }, py::arg("key"), py::arg("data"), py::arg("offsets"), py::arg("threads") = 1,
+             "Encrypts messages packed in one buffer and split by offsets. Returns (data, offsets).")
+        .def_static("decrypt_batch", [](const SessionKey &key, const py::iterable &messages, size_t threads) {
+            return decrypt_batch(key, batch_input_from_list(messages), threads);
+        }, py::arg("key"), py::arg("messages"), py::arg("threads") = 1,
+             "Decrypts a list of bytes-like ciphertexts with the GIL released. Returns (data, offsets).")
+        .def_static("decrypt_batch", [](const SessionKey &key, const py::buffer &data,
+                                        const std::vector<size_t> &offsets, size_t threads) {
+            return decrypt_batch(key, batch_input_from_offsets(data, offsets), threads);
+        }, py::arg("key"), py::arg("data"), py::arg("offsets"), py::arg("threads") = 1,
+             "Decrypts ciphertexts packed in one buffer and split by offsets, e.g. the output of encrypt_batch.");
     
     py::class_<Crypto::SessionKeys>(m, "SessionKeys")
         .def(py::init<>())
@@ -157,13 +1709,49 @@ PYBIND11_MODULE(_obscuraproto, m) {
         .def_readwrite("tx", &Crypto::SessionKeys::tx);
 
     // Packet
-    py::class_<Payload>(m, "Payload")
+    py::class_<Payload>(m, "Payload", py::buffer_protocol())
         .def(py::init<>(), "Default constructor")
+        .def(py::init([](Payload::OpCode op_code, const py::buffer &parameters) {
+            Payload payload;
+            payload.op_code = op_code;
+            payload.parameters = ContiguousBuffer(parameters).to_vector();
+            return payload;
+        }), py::arg("op_code"), py::arg("parameters"),
+             "Constructs a payload from an opcode and any bytes-like object holding the raw parameters data.")
         .def_readwrite("op_code", &Payload::op_code, "The operation code.")
-        .def_readwrite("parameters", &Payload::parameters, "The raw parameters data.")
+        // Read-only: the buffer protocol exports a pointer into `parameters`, and
+        // reassigning the vector would leave open memoryviews dangling.
+        .def_property_readonly("parameters", [](const Payload &self) { return self.parameters; },
+                               "The raw parameters data as a list of ints (a copy). Prefer memoryview(payload) for "
+                               "large payloads; build a new Payload(op_code, buffer) to change them.")
+        .def_buffer([](Payload &self) {
+            return py::buffer_info(self.parameters.data(), static_cast<py::ssize_t>(self.parameters.size()), true);
+        })
+        .def_property_readonly("parameters_view", [](py::object self) {
+            return py::memoryview(self);
+        }, "A read-only memoryview over the raw parameters data. Keeps the payload alive.")
         .def("serialize", &Payload::serialize, "Serializes the payload into a single byte vector.")
         .def_static("deserialize", &Payload::deserialize, "Deserializes a byte vector into a Payload object.");
 
+    py::enum_<ParamType>(m, "ParamType")
+        .value("STRING", ParamType::STRING)
+        .value("INT", ParamType::INT)
+        .value("UINT", ParamType::UINT)
+        .value("FLOAT", ParamType::FLOAT)
+        .value("BOOL", ParamType::BOOL)
+        .value("BYTES", ParamType::BYTES)
+        .value("BYTES_VIEW", ParamType::BYTES_VIEW)
+        .value("INT32_ARRAY", ParamType::INT32_ARRAY)
+        .value("INT64_ARRAY", ParamType::INT64_ARRAY)
+        .value("FLOAT32_ARRAY", ParamType::FLOAT32_ARRAY)
+        .value("FLOAT64_ARRAY", ParamType::FLOAT64_ARRAY);
+
+    py::class_<PayloadSchema>(m, "PayloadSchema")
+        .def(py::init<std::vector<ParamType>>(), py::arg("types"),
+             "Compiles a sequence of ParamType values into a reusable schema.")
+        .def_readonly("types", &PayloadSchema::types, "The parameter types, in payload order.")
+        .def("__len__", [](const PayloadSchema &self) { return self.types.size(); });
+
     py::class_<PayloadBuilder>(m, "PayloadBuilder")
         .def(py::init<Payload::OpCode>(), "Constructor that takes an opcode.")
         .def("add_param", py::overload_cast<const byte_vector&>(&PayloadBuilder::add_param))
@@ -180,56 +1768,59 @@ PYBIND11_MODULE(_obscuraproto, m) {
         .def("add_param", py::overload_cast<uint64_t>(&PayloadBuilder::add_param))
         .def("add_param", py::overload_cast<float>(&PayloadBuilder::add_param))
         .def("add_param", py::overload_cast<double>(&PayloadBuilder::add_param))
-        .def("build", &PayloadBuilder::build, "Builds the final Payload object.");
+        .def("add_array", [](PayloadBuilder &self, const py::buffer &values, ParamType type) -> PayloadBuilder& {
+            self.add_param(encode_array(values, checked_array_format(type)));
+            return self;
+        }, py::arg("values"), py::arg("type"), py::return_value_policy::reference_internal,
+             "Adds a numeric array from any buffer-protocol object (array.array, numpy, memoryview) whose elements "
+             "match the array ParamType. Elements are stored little-endian.")
+        .def("build", &PayloadBuilder::build, "Builds the final Payload object.")
+        .def_static("build_from", &build_from, py::arg("op_code"), py::arg("values"), py::arg("schema"),
+                    "Builds a Payload from a sequence of values encoded according to a PayloadSchema, in one call.");
+
+    py::class_<PayloadView>(m, "PayloadView")
+        .def(py::init<py::object>(), py::arg("payload"),
+             "Creates a read cursor over an existing Payload without copying its parameters.")
+        .def_property_readonly("op_code", &PayloadView::op_code, "The operation code.")
+        .def_property_readonly("data", &PayloadView::data, "A read-only memoryview over the raw parameters data.")
+        .def("has_more", &PayloadView::has_more, "Returns true if there are more parameters to read.")
+        .def("peek_next_param_size", &PayloadView::peek_next_param_size,
+             "Returns the size of the next parameter in bytes without advancing the view.")
+        .def("read_string", &PayloadView::read_string, "Reads a string parameter.")
+        .def("read_bytes", &PayloadView::read_bytes, "Reads a bytes parameter.")
+        .def("read_bytes_view", &PayloadView::read_bytes_view,
+             "Reads a bytes parameter as a memoryview into the payload, without copying it.")
+        .def("read_bool", &PayloadView::read_bool, "Reads a boolean parameter.")
+        .def("read_int", &PayloadView::read_int, "Reads a signed integer, determining its size from the packet.")
+        .def("read_uint", &PayloadView::read_uint, "Reads an unsigned integer, determining its size from the packet.")
+        .def("read_float", &PayloadView::read_float,
+             "Reads a float or double, determining its size from the packet and returning it as a double.")
+        .def("read_array", &PayloadView::read_array, py::arg("type"),
+             "Reads a numeric array parameter as a typed memoryview. On little-endian hosts it points into the "
+             "payload without copying; wrap it with numpy.frombuffer() for a numpy array.")
+        .def("read_all", &read_all_view, py::arg("schema"),
+             "Reads all parameters described by a PayloadSchema in one call. BYTES_VIEW and array parameters are "
+             "returned as memoryviews into the payload.");
 
     py::class_<PayloadReader>(m, "PayloadReader")
         .def(py::init<const Payload&>(), "Constructor that takes a payload to read from.")
+        .def(py::init([](const PayloadView &view) { return PayloadReader(view.payload()); }), py::arg("view"),
+             py::keep_alive<1, 2>(), "Constructor that reads the payload behind a PayloadView.")
         .def("has_more", &PayloadReader::has_more, "Returns true if there are more parameters to read.")
         .def("peek_next_param_size", &PayloadReader::peek_next_param_size, "Returns the size of the next parameter in bytes without advancing the reader.")
         .def("read_string", &PayloadReader::read_param<std::string>, "Reads a string parameter.")
         .def("read_bytes", &PayloadReader::read_param<byte_vector>, "Reads a bytes parameter.")
         .def("read_bool", &PayloadReader::read_param<bool>, "Reads a boolean parameter.")
-        .def("read_int", [](PayloadReader &self) -> int64_t {
-            size_t size = self.peek_next_param_size();
-            switch (size) {
-                case 1:
-                    return self.read_param<int8_t>();
-                case 2:
-                    return self.read_param<int16_t>();
-                case 4:
-                    return self.read_param<int32_t>();
-                case 8:
-                    return self.read_param<int64_t>();
-                default:
-                    throw std::runtime_error("Invalid size for a signed integer parameter: " + std::to_string(size));
-            }
-        }, "Reads a signed integer, determining its size from the packet.")
-        .def("read_uint", [](PayloadReader &self) -> uint64_t {
-            size_t size = self.peek_next_param_size();
-            switch (size) {
-                case 1:
-                    return self.read_param<uint8_t>();
-                case 2:
-                    return self.read_param<uint16_t>();
-                case 4:
-                    return self.read_param<uint32_t>();
-                case 8:
-                    return self.read_param<uint64_t>();
-                default:
-                    throw std::runtime_error("Invalid size for an unsigned integer parameter: " + std::to_string(size));
-            }
-        }, "Reads an unsigned integer, determining its size from the packet.")
-        .def("read_float", [](PayloadReader &self) -> double {
-            size_t size = self.peek_next_param_size();
-            switch (size) {
-                case 4:
-                    return self.read_param<float>();
-                case 8:
-                    return self.read_param<double>();
-                default:
-                    throw std::runtime_error("Invalid size for a float/double parameter: " + std::to_string(size));
-            }
-        }, "Reads a float or double, determining its size from the packet and returning it as a double.");
+        .def("read_int", &read_signed, "Reads a signed integer, determining its size from the packet.")
+        .def("read_uint", &read_unsigned, "Reads an unsigned integer, determining its size from the packet.")
+        .def("read_float", &read_floating,
+             "Reads a float or double, determining its size from the packet and returning it as a double.")
+        .def("read_array", [](PayloadReader &reader, ParamType type) {
+            checked_array_format(type);
+            return read_typed_param(reader, type);
+        }, py::arg("type"), "Reads a numeric array parameter into a typed memoryview over a copy of its data.")
+        .def("read_all", &read_all, py::arg("schema"),
+             "Reads all parameters described by a PayloadSchema in one call and returns them as a tuple.");
     
     // Stream
     py::class_<Stream, std::shared_ptr<Stream>>(m, "CppStream")
@@ -237,22 +1828,55 @@ PYBIND11_MODULE(_obscuraproto, m) {
              "Constructor (stream_id, send_fn) - for testing. Use start_stream() in production.")
         .def("get_stream_id", &Stream::get_stream_id,
              "Returns the stream's unique ID.")
-        .def("write", [](Stream &self, const std::string &data) {
-            byte_vector vec(reinterpret_cast<const uint8_t*>(data.data()),
-                            reinterpret_cast<const uint8_t*>(data.data() + data.size()));
-            self.write(vec);
-        }, py::call_guard<py::gil_scoped_release>(),
-             "Send a data chunk over the stream.")
+        .def("write", [](Stream &self, const py::buffer &data) {
+            ContiguousBuffer chunk(data);
+            py::gil_scoped_release release;
+            self.write(chunk.to_vector());
+        }, py::arg("data"),
+             "Send a data chunk (any bytes-like object) over the stream.")
+        .def("write_many", [](Stream &self, const py::iterable &chunks) {
+            std::vector<std::unique_ptr<ContiguousBuffer>> views;
+            size_t total = 0;
+            for (py::handle chunk : chunks) {
+                views.push_back(std::make_unique<ContiguousBuffer>(chunk));
+                total += views.back()->size();
+            }
+            py::gil_scoped_release release;
+            byte_vector data;
+            data.reserve(total);
+            for (const auto &view : views) {
+                data.insert(data.end(), view->data(), view->data() + view->size());
+            }
+            self.write(data);
+        }, py::arg("chunks"),
+             "Send several bytes-like objects as a single data chunk (one encrypted frame).")
+        .def("write_large", [](Stream &self, const py::buffer &data, size_t chunk_size) {
+            checked_chunk_size(chunk_size);
+            ContiguousBuffer source(data);
+            py::gil_scoped_release release;
+            write_chunked(self, source.data(), source.size(), chunk_size);
+        }, py::arg("data"), py::arg("chunk_size") = DEFAULT_CHUNK_SIZE,
+             "Send a large bytes-like object as chunk_size-sized data chunks in one call, with the GIL released.")
+        .def("send_file", &send_file, py::arg("path"), py::arg("chunk_size") = DEFAULT_CHUNK_SIZE,
+             "Stream a file in chunk_size-sized data chunks with the GIL released. Returns the number of bytes sent.")
         .def("end", &Stream::end, py::call_guard<py::gil_scoped_release>(),
              "Signal end of outgoing data (half-close).")
         .def("cancel", &Stream::cancel, py::call_guard<py::gil_scoped_release>(),
              "Abort the stream immediately.")
-        .def("set_data_handler", &Stream::set_data_handler,
-             "Register callback for incoming data chunks.")
+        .def("set_data_handler", [](Stream &self, std::function<void(py::bytes)> callback) {
+            self.set_data_handler([callback](const byte_vector &data) {
+                py::gil_scoped_acquire gil;
+                callback(py::bytes(reinterpret_cast<const char*>(data.data()), data.size()));
+            });
+        }, "Register callback for incoming data chunks. The callback receives each chunk as bytes.")
         .def("set_end_handler", &Stream::set_end_handler,
              "Register callback for remote end-of-stream.")
         .def("set_cancel_handler", &Stream::set_cancel_handler,
-             "Register callback for remote stream cancel.");
+             "Register callback for remote stream cancel.")
+        .def("set_collect_handler", &set_collect_handler, py::arg("callback"), py::arg("max_size") = 64 << 20,
+             "Reassemble all incoming data chunks natively and deliver them as one bytes object when the "
+             "remote side ends the stream. Replaces the data and end handlers. If more than max_size bytes "
+             "arrive, the stream is cancelled and the callback is not called.");
 
     // Session
     py::enum_<Role>(m, "Role")
@@ -268,108 +1892,288 @@ PYBIND11_MODULE(_obscuraproto, m) {
         });
 
     // WS Server
-    py::class_<WsServerWrapper>(m, "WsServer")
+    py::class_<BoundWsServer>(m, "WsServer")
         .def(py::init<KeyPair, Config>(), py::arg("keypair"), py::arg("config") = Config::with_defaults())
         .def("run", &WsServerWrapper::run, py::call_guard<py::gil_scoped_release>(),
              "Runs the server in a background thread.")
         .def("stop", &WsServerWrapper::stop, py::call_guard<py::gil_scoped_release>(),
              "Stops the server thread.")
-        .def("send", [](WsServerWrapper &self, WsConnectionHdlWrapper hdl, const Payload &payload) {
-            self.send(hdl.hdl, payload);
+        .def("send", [](BoundWsServer &server, WsConnectionHdlWrapper hdl, const Payload &payload) {
+            auto metrics = server.metrics;
+            py::gil_scoped_release release;
+            server.send(hdl.hdl, payload);
+            metrics->sent.add(payload);
         }, "Send a payload to a specific client.")
-        .def("sync_request", [](WsServerWrapper &self, WsConnectionHdlWrapper hdl, const Payload &payload) {
-            return self.sync_request(hdl.hdl, payload);
-        }, py::call_guard<py::gil_scoped_release>(), "Sends a request to a client and returns a response.")
-        .def("register_op_handler", [](WsServerWrapper &self, Payload::OpCode op_code, 
-                                       std::function<void(WsConnectionHdlWrapper, Payload)> callback) {
-            self.register_op_handler(op_code, [callback](WsConnectionHdl hdl, Payload payload) {
-                callback(WsConnectionHdlWrapper{hdl}, payload);
+        .def("broadcast", [](BoundWsServer &server, const Payload &payload,
+                             const std::vector<WsConnectionHdlWrapper> &hdls, size_t workers) {
+            auto metrics = server.metrics;
+            py::gil_scoped_release release;
+            size_t sent = fan_out(hdls, workers, [&](const WsConnectionHdlWrapper &hdl) { server.send(hdl.hdl, payload); });
+            metrics->sent.add(payload, sent);
+            return sent;
+        }, py::arg("payload"), py::arg("hdls"), py::arg("workers") = 1,
+             "Send a payload to many clients in one call with the GIL released. Returns the number of sends queued.")
+        .def("broadcast", [](BoundWsServer &server, const Payload &payload,
+                             const std::vector<PublicKey> &identities, size_t workers) {
+            auto metrics = server.metrics;
+            py::gil_scoped_release release;
+            size_t sent = fan_out(identities, workers,
+                                  [&](const PublicKey &identity_pk) { server.send_to_identity(identity_pk, payload); });
+            metrics->sent.add(payload, sent);
+            return sent;
+        }, py::arg("payload"), py::arg("identities"), py::arg("workers") = 1,
+             "Send a payload to many clients identified by their public keys. Returns the number of sends queued.")
+        .def("sync_request", [](py::object self, WsConnectionHdlWrapper hdl, const Payload &payload,
+                                std::optional<double> timeout) {
+            auto &server = self.cast<BoundWsServer&>();
+            auto metrics = server.metrics;
+            if (timeout) {
+                return request_with_timeout(self, [&server, metrics, hdl, payload] {
+                    return timed_request(*metrics, payload, [&] { return server.sync_request(hdl.hdl, payload); });
+                }, *timeout);
+            }
+            py::gil_scoped_release release;
+            return timed_request(*metrics, payload, [&] { return server.sync_request(hdl.hdl, payload); });
+        }, py::arg("hdl"), py::arg("payload"), py::arg("timeout") = py::none(),
+             "Sends a request to a client and returns a response. Raises TimeoutError after timeout seconds.")
+        .def("request_async", [](py::object self, WsConnectionHdlWrapper hdl, const Payload &payload,
+                                 std::function<void(py::object, py::object)> on_done) {
+            auto &server = self.cast<BoundWsServer&>();
+            return run_request_async(self, [&server, metrics = server.metrics, hdl, payload] {
+                return timed_request(*metrics, payload, [&] { return server.sync_request(hdl.hdl, payload); });
+            }, std::move(on_done));
+        }, py::arg("hdl"), py::arg("payload"), py::arg("on_done"),
+             "Sends a request to a client without blocking; on_done(response, error) is called "
+             "from a native thread. Returns a PendingRequest.")
+        .def("request_many", [](BoundWsServer &server, WsConnectionHdlWrapper hdl,
+                                const std::vector<Payload> &payloads, size_t max_in_flight) {
+            auto metrics = server.metrics;
+            py::gil_scoped_release release;
+            return pipeline_requests(payloads.size(), max_in_flight, [&](size_t i) {
+                return timed_request(*metrics, payloads[i], [&] { return server.sync_request(hdl.hdl, payloads[i]); });
             });
+        }, py::arg("hdl"), py::arg("payloads"), py::arg("max_in_flight") = 8,
+             "Sends many requests to a client, keeping up to max_in_flight outstanding, and returns the responses "
+             "in order.")
+        .def("register_op_handler", [](BoundWsServer &self, Payload::OpCode op_code, py::function callback) {
+            auto metrics = self.metrics;
+            self.register_op_handler(
+                op_code, make_payload_handler(std::move(callback), metrics, metrics->opcode(op_code)));
         }, "Register a handler for a specific opcode.")
-        .def("register_request_handler", [](WsServerWrapper &self, Payload::OpCode op_code, 
-                                            std::function<Payload(WsConnectionHdlWrapper, PayloadReader&)> callback) {
-            self.register_request_handler(op_code, [callback](WsConnectionHdl hdl, PayloadReader& reader) {
-                return callback(WsConnectionHdlWrapper{hdl}, reader);
-            });
+        .def("register_batch_op_handler", [](BoundWsServer &self, Payload::OpCode op_code,
+                                             std::function<void(py::list)> callback,
+                                             size_t max_batch, uint64_t max_delay_us) {
+            auto batcher = make_batcher<HdlPayload>(std::move(callback), max_batch, max_delay_us);
+            auto metrics = self.metrics;
+            auto opcode = metrics->opcode(op_code);
+            self.register_op_handler(
+                op_code, [batcher, metrics, opcode](WsConnectionHdl hdl, Payload payload) {
+                    metrics->received.add(payload);
+                    opcode->received.add(payload);
+                    batcher->push({hdl, std::move(payload)});
+                });
+        }, py::arg("op_code"), py::arg("callback"), py::arg("max_batch") = 64, py::arg("max_delay_us") = 1000,
+             "Register a handler that receives lists of (hdl, payload) tuples for a specific opcode, "
+             "flushed every max_batch payloads or max_delay_us microseconds.")
+        .def("register_request_handler", [](BoundWsServer &self, Payload::OpCode op_code, py::function callback) {
+            auto metrics = self.metrics;
+            self.register_request_handler(
+                op_code, make_request_handler(std::move(callback), metrics, metrics->opcode(op_code)));
         }, "Register a request handler for a specific opcode, expecting a Payload response.")
-        .def("set_default_payload_handler", [](WsServerWrapper &self,
-                                                std::function<void(WsConnectionHdlWrapper, Payload)> callback) {
-            self.set_default_payload_handler([callback](WsConnectionHdl hdl, Payload payload) {
-                callback(WsConnectionHdlWrapper{hdl}, payload);
-            });
+        .def("set_default_payload_handler", [](BoundWsServer &self, py::function callback) {
+            self.set_default_payload_handler(
+                make_payload_handler(std::move(callback), self.metrics));
         }, "Sets the default handler for unhandled opcodes.")
-        .def("start_stream", [](WsServerWrapper &self, WsConnectionHdlWrapper hdl) {
+        .def("start_stream", [](BoundWsServer &self, WsConnectionHdlWrapper hdl) {
             return self.start_stream(hdl.hdl);
         }, py::call_guard<py::gil_scoped_release>(),
              "Start a new outgoing stream to a specific client.")
-        .def("register_incoming_stream_handler", [](WsServerWrapper &self,
+        .def("register_incoming_stream_handler", [](BoundWsServer &self,
             std::function<void(std::shared_ptr<Stream>)> callback) {
             self.register_incoming_stream_handler(std::move(callback));
         }, "Register a handler for incoming streams from clients.")
 
         // --- Anonymous Sessions ---
-        .def("send_anonymous", [](WsServerWrapper &self, WsConnectionHdlWrapper hdl, const Payload &payload) {
-            self.send_anonymous(hdl.hdl, payload);
+        .def("send_anonymous", [](BoundWsServer &server, WsConnectionHdlWrapper hdl, const Payload &payload) {
+            auto metrics = server.metrics;
+            py::gil_scoped_release release;
+            server.send_anonymous(hdl.hdl, payload);
+            metrics->sent.add(payload);
         }, "Send a payload to an anonymous session.")
-        .def("register_anon_op_handler", [](WsServerWrapper &self, Payload::OpCode op_code,
-                                            std::function<void(WsConnectionHdlWrapper, Payload)> callback) {
-            self.register_anon_op_handler(op_code, [callback](WsConnectionHdl hdl, Payload payload) {
-                callback(WsConnectionHdlWrapper{hdl}, payload);
-            });
+        .def("broadcast_anonymous", [](BoundWsServer &server, const Payload &payload,
+                                       const std::vector<WsConnectionHdlWrapper> &hdls, size_t workers) {
+            auto metrics = server.metrics;
+            py::gil_scoped_release release;
+            size_t sent = fan_out(hdls, workers,
+                                  [&](const WsConnectionHdlWrapper &hdl) { server.send_anonymous(hdl.hdl, payload); });
+            metrics->sent.add(payload, sent);
+            return sent;
+        }, py::arg("payload"), py::arg("hdls"), py::arg("workers") = 1,
+             "Send a payload to many anonymous sessions in one call. Returns the number of sends queued.")
+        .def("register_anon_op_handler", [](BoundWsServer &self, Payload::OpCode op_code, py::function callback) {
+            auto metrics = self.metrics;
+            self.register_anon_op_handler(
+                op_code, make_payload_handler(std::move(callback), metrics, metrics->opcode(op_code)));
         }, "Register a handler for a specific opcode on anonymous sessions.")
-        .def("register_anon_request_handler", [](WsServerWrapper &self, Payload::OpCode op_code,
-                                                 std::function<Payload(WsConnectionHdlWrapper, PayloadReader&)> callback) {
-            self.register_anon_request_handler(op_code, [callback](WsConnectionHdl hdl, PayloadReader& reader) {
-                return callback(WsConnectionHdlWrapper{hdl}, reader);
-            });
+        .def("register_anon_batch_op_handler", [](BoundWsServer &self, Payload::OpCode op_code,
+                                                  std::function<void(py::list)> callback,
+                                                  size_t max_batch, uint64_t max_delay_us) {
+            auto batcher = make_batcher<HdlPayload>(std::move(callback), max_batch, max_delay_us);
+            auto metrics = self.metrics;
+            auto opcode = metrics->opcode(op_code);
+            self.register_anon_op_handler(
+                op_code, [batcher, metrics, opcode](WsConnectionHdl hdl, Payload payload) {
+                    metrics->received.add(payload);
+                    opcode->received.add(payload);
+                    batcher->push({hdl, std::move(payload)});
+                });
+        }, py::arg("op_code"), py::arg("callback"), py::arg("max_batch") = 64, py::arg("max_delay_us") = 1000,
+             "Batched variant of register_anon_op_handler.")
+        .def("register_anon_request_handler", [](BoundWsServer &self, Payload::OpCode op_code, py::function callback) {
+            auto metrics = self.metrics;
+            self.register_anon_request_handler(
+                op_code, make_request_handler(std::move(callback), metrics, metrics->opcode(op_code)));
         }, "Register a request handler for anonymous sessions.")
-        .def("set_anon_default_payload_handler", [](WsServerWrapper &self,
-                                                     std::function<void(WsConnectionHdlWrapper, Payload)> callback) {
-            self.set_anon_default_payload_handler([callback](WsConnectionHdl hdl, Payload payload) {
-                callback(WsConnectionHdlWrapper{hdl}, payload);
-            });
+        .def("set_anon_default_payload_handler", [](BoundWsServer &self, py::function callback) {
+            self.set_anon_default_payload_handler(
+                make_payload_handler(std::move(callback), self.metrics));
         }, "Sets the default handler for unhandled opcodes from anonymous clients.")
 
         // --- Client Identity ---
-        .def("set_client_identity_handler", [](WsServerWrapper &self,
+        .def("set_client_identity_handler", [](BoundWsServer &self,
                                                 std::function<bool(WsConnectionHdlWrapper, PublicKey)> callback) {
             self.set_client_identity_handler([callback](WsConnectionHdl hdl, PublicKey pk) {
                 return callback(WsConnectionHdlWrapper{hdl}, pk);
             });
         }, "Sets a handler that is called when a client authenticates with an identity key.")
-        .def("get_client_identity", [](WsServerWrapper &self, WsConnectionHdlWrapper hdl) {
+        .def("get_client_identity", [](BoundWsServer &self, WsConnectionHdlWrapper hdl) {
             return self.get_client_identity(hdl.hdl);
         }, "Gets the verified identity public key for an authenticated session.")
-        .def("send_to_identity", &WsServerWrapper::send_to_identity,
-             "Send a payload to a specific client identified by their public key.")
-        .def("sync_request_to_identity", &WsServerWrapper::sync_request_to_identity,
-             py::call_guard<py::gil_scoped_release>(),
-             "Sends a synchronous request to a specific client identified by their public key.")
-        .def("send_response", [](WsServerWrapper &self, WsConnectionHdlWrapper hdl, uint32_t request_id, const Payload &payload) {
-            self.send_response(hdl.hdl, request_id, payload);
-        }, "Sends a response to a specific request.");
+        .def("send_to_identity", [](BoundWsServer &server, const PublicKey &identity_pk, const Payload &payload) {
+            auto metrics = server.metrics;
+            py::gil_scoped_release release;
+            server.send_to_identity(identity_pk, payload);
+            metrics->sent.add(payload);
+        }, "Send a payload to a specific client identified by their public key.")
+        .def("sync_request_to_identity", [](py::object self, const PublicKey &identity_pk, const Payload &payload,
+                                            std::optional<double> timeout) {
+            auto &server = self.cast<BoundWsServer&>();
+            auto metrics = server.metrics;
+            if (timeout) {
+                return request_with_timeout(self, [&server, metrics, identity_pk, payload] {
+                    return timed_request(*metrics, payload,
+                                         [&] { return server.sync_request_to_identity(identity_pk, payload); });
+                }, *timeout);
+            }
+            py::gil_scoped_release release;
+            return timed_request(*metrics, payload,
+                                 [&] { return server.sync_request_to_identity(identity_pk, payload); });
+        }, py::arg("identity_pk"), py::arg("payload"), py::arg("timeout") = py::none(),
+             "Sends a synchronous request to a specific client identified by their public key. "
+             "Raises TimeoutError after timeout seconds.")
+        .def("request_to_identity_async", [](py::object self, const PublicKey &identity_pk, const Payload &payload,
+                                             std::function<void(py::object, py::object)> on_done) {
+            auto &server = self.cast<BoundWsServer&>();
+            return run_request_async(self, [&server, metrics = server.metrics, identity_pk, payload] {
+                return timed_request(*metrics, payload,
+                                     [&] { return server.sync_request_to_identity(identity_pk, payload); });
+            }, std::move(on_done));
+        }, py::arg("identity_pk"), py::arg("payload"), py::arg("on_done"),
+             "Non-blocking variant of sync_request_to_identity; on_done(response, error) is called "
+             "from a native thread. Returns a PendingRequest.")
+        .def("send_response", [](BoundWsServer &server, WsConnectionHdlWrapper hdl, uint32_t request_id,
+                                 const Payload &payload) {
+            auto metrics = server.metrics;
+            py::gil_scoped_release release;
+            server.send_response(hdl.hdl, request_id, payload);
+            metrics->sent.add(payload);
+        }, "Sends a response to a specific request.")
+        .def("stats", [](BoundWsServer &self) { return self.metrics->to_dict(); },
+             "Returns counters and latency histograms for traffic that passed through the bindings.");
 
     // WS Client
-    py::class_<WsClientWrapper>(m, "WsClient")
+    py::class_<BoundWsClient>(m, "WsClient")
         .def(py::init<KeyPair, Config>(), py::arg("keypair"), py::arg("config") = Config::with_defaults())
         .def("connect", &WsClientWrapper::connect, py::call_guard<py::gil_scoped_release>(),
              "Connects to the server and performs handshake.")
         .def("disconnect", &WsClientWrapper::disconnect, py::call_guard<py::gil_scoped_release>(),
              "Disconnects from the server.")
-        .def("send", &WsClientWrapper::send, py::call_guard<py::gil_scoped_release>(),
-             "Sends a payload to the server.")
-        .def("sync_request", [](WsClientWrapper &self, const Payload &payload) {
-            return self.sync_request(payload);
-        }, py::call_guard<py::gil_scoped_release>(), "Sends a request to the server and returns a response.")
+        .def("send", [](BoundWsClient &client, const Payload &payload) {
+            auto metrics = client.metrics;
+            py::gil_scoped_release release;
+            client.send(payload);
+            metrics->sent.add(payload);
+        }, "Sends a payload to the server.")
+        .def("sync_request", [](py::object self, const Payload &payload, std::optional<double> timeout) {
+            auto &client = self.cast<BoundWsClient&>();
+            auto metrics = client.metrics;
+            if (timeout) {
+                return request_with_timeout(self, [&client, metrics, payload] {
+                    return timed_request(*metrics, payload, [&] { return client.sync_request(payload); });
+                }, *timeout);
+            }
+            py::gil_scoped_release release;
+            return timed_request(*metrics, payload, [&] { return client.sync_request(payload); });
+        }, py::arg("payload"), py::arg("timeout") = py::none(),
+             "Sends a request to the server and returns a response. Raises TimeoutError after timeout seconds.")
+        .def("request_async", [](py::object self, const Payload &payload,
+                                 std::function<void(py::object, py::object)> on_done) {
+            auto &client = self.cast<BoundWsClient&>();
+            return run_request_async(self, [&client, metrics = client.metrics, payload] {
+                return timed_request(*metrics, payload, [&] { return client.sync_request(payload); });
+            }, std::move(on_done));
+        }, py::arg("payload"), py::arg("on_done"),
+             "Sends a request to the server without blocking; on_done(response, error) is called "
+             "from a native thread. Returns a PendingRequest.")
+        .def("request_many", [](BoundWsClient &client, const std::vector<Payload> &payloads, size_t max_in_flight) {
+            auto metrics = client.metrics;
+            py::gil_scoped_release release;
+            return pipeline_requests(payloads.size(), max_in_flight, [&](size_t i) {
+                return timed_request(*metrics, payloads[i], [&] { return client.sync_request(payloads[i]); });
+            });
+        }, py::arg("payloads"), py::arg("max_in_flight") = 8,
+             "Sends many requests to the server, keeping up to max_in_flight outstanding, and returns the responses "
+             "in order.")
         .def("set_client_identity", &WsClientWrapper::set_client_identity,
              "Sets the client's Ed25519 identity keypair for authentication.")
         .def("set_on_ready_callback", &WsClientWrapper::set_on_ready_callback)
         .def("set_on_disconnect_callback", &WsClientWrapper::set_on_disconnect_callback)
-        .def("register_op_handler", &WsClientWrapper::register_op_handler)
-        .def("register_request_handler", &WsClientWrapper::register_request_handler, "Register a request handler for a specific opcode, expecting a Payload response.")
-        .def("set_default_payload_handler", &WsClientWrapper::set_default_payload_handler)
-        .def("send_response", &WsClientWrapper::send_response,
-             "Sends a response to a specific server-initiated request.")
+        .def("register_op_handler", [](BoundWsClient &self, Payload::OpCode op_code, py::function callback) {
+            auto metrics = self.metrics;
+            self.register_op_handler(
+                op_code, make_client_payload_handler(std::move(callback), metrics, metrics->opcode(op_code)));
+        }, "Register a handler for a specific opcode.")
+        .def("register_batch_op_handler", [](BoundWsClient &self, Payload::OpCode op_code,
+                                             std::function<void(py::list)> callback,
+                                             size_t max_batch, uint64_t max_delay_us) {
+            auto batcher = make_batcher<Payload>(std::move(callback), max_batch, max_delay_us);
+            auto metrics = self.metrics;
+            auto opcode = metrics->opcode(op_code);
+            self.register_op_handler(op_code, [batcher, metrics, opcode](Payload payload) {
+                metrics->received.add(payload);
+                opcode->received.add(payload);
+                batcher->push(std::move(payload));
+            });
+        }, py::arg("op_code"), py::arg("callback"), py::arg("max_batch") = 64, py::arg("max_delay_us") = 1000,
+             "Register a handler that receives lists of payloads for a specific opcode, "
+             "flushed every max_batch payloads or max_delay_us microseconds.")
+        .def("register_request_handler", [](BoundWsClient &self, Payload::OpCode op_code, py::function callback) {
+            auto metrics = self.metrics;
+            self.register_request_handler(
+                op_code, make_client_request_handler(std::move(callback), metrics, metrics->opcode(op_code)));
+        }, "Register a request handler for a specific opcode, expecting a Payload response.")
+        .def("set_default_payload_handler", [](BoundWsClient &self, py::function callback) {
+            self.set_default_payload_handler(
+                make_client_payload_handler(std::move(callback), self.metrics));
+        })
+        .def("send_response", [](BoundWsClient &client, uint32_t request_id, const Payload &payload) {
+            auto metrics = client.metrics;
+            py::gil_scoped_release release;
+            client.send_response(request_id, payload);
+            metrics->sent.add(payload);
+        }, "Sends a response to a specific server-initiated request.")
+        .def("stats", [](BoundWsClient &self) { return self.metrics->to_dict(); },
+             "Returns counters and latency histograms for traffic that passed through the bindings.")
         .def("start_stream", &WsClientWrapper::start_stream, py::call_guard<py::gil_scoped_release>(),
              "Start a new outgoing stream to the server.")
         .def("register_incoming_stream_handler", &WsClientWrapper::register_incoming_stream_handler,
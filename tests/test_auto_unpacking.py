@@ -116,3 +116,20 @@ def test_auto_unpacking(crypto_init, capsys):
         time.sleep(0.1)
         captured = capsys.readouterr()
         print(captured.out)
+
+
+def test_unsupported_type_hint_rejected_at_registration(crypto_init):
+    """Handler signatures are compiled once, so bad type hints fail when the handler is registered."""
+    server = op.Server()
+
+    with pytest.raises(TypeError):
+
+        @server.on_anon_payload(OP_UNPACK_TEST)
+        def bad_handler(hdl: op.ConnectionHdl, value: dict):
+            pass
+
+    with pytest.raises(TypeError):
+
+        @server.on_anon_request(OP_UNPACK_TEST)
+        def bad_request_handler(hdl: op.ConnectionHdl, value) -> op.Payload:
+            return op.PayloadBuilder(OP_RESPONSE).build()
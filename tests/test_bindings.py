@@ -292,3 +292,313 @@ def test_python_stream_wrapper():
     stream.cancel()
     assert len(sent) == 4
     assert sent[3].op_code == 0xFFFA
+
+
+def test_payload_buffer_protocol():
+    """
+    Tests zero-copy access to Payload parameters through the buffer protocol
+    and construction of a Payload from a bytes-like object.
+    """
+    payload = PayloadBuilder(0x10).add_param(b"abc").add_param("text").build()
+
+    view = memoryview(payload)
+    assert view.readonly
+    assert view.format == "B"
+    assert bytes(view) == bytes(payload.parameters)
+    assert bytes(payload.parameters_view) == bytes(view)
+
+    # Any contiguous buffer can back a new payload without a list round trip
+    for source in (bytes(view), bytearray(view), view):
+        copy = Payload(0x10, source)
+        assert copy.op_code == 0x10
+        reader = PayloadReader(copy)
+        assert bytes(reader.read_bytes()) == b"abc"
+        assert reader.read_string() == "text"
+        assert not reader.has_more()
+
+    # The view keeps the payload alive after the last Python reference is dropped
+    view = Payload(0x11, b"\x01\x02\x03").parameters_view
+    assert bytes(view) == b"\x01\x02\x03"
+
+    # The exported buffer cannot be invalidated by reassigning the parameters
+    with pytest.raises(AttributeError):
+        payload.parameters = [1, 2, 3]
+    assert bytes(memoryview(payload)) == bytes(payload.parameters)
+
+
+def test_stream_write_buffers():
+    """
+    Tests that CppStream.write accepts any bytes-like object and that
+    write_many gathers several buffers into a single STREAM_DATA frame.
+    """
+    sent = []
+    stream = _bindings.CppStream(5, lambda p: sent.append(p))
+
+    stream.write(bytearray(b"abc"))
+    stream.write(memoryview(b"xxdefxx")[2:5])
+    stream.write_many([b"gh", bytearray(b"ij"), memoryview(b"kl")])
+
+    assert len(sent) == 3
+    chunks = []
+    for p in sent:
+        assert p.op_code == 0xFFFC  # STREAM_DATA
+        reader = PayloadReader(p)
+        assert reader.read_uint() == 5
+        chunks.append(bytes(reader.read_bytes()))
+    assert chunks == [b"abc", b"def", b"ghijkl"]
+
+    with pytest.raises(TypeError):
+        stream.write("not a buffer")
+
+
+def test_stream_write_large_and_send_file(tmp_path):
+    """
+    Tests that write_large and send_file split their input into chunk_size
+    STREAM_DATA frames natively.
+    """
+    sent = []
+    stream = _bindings.CppStream(6, lambda p: sent.append(p))
+
+    def sent_chunks():
+        chunks = []
+        for p in sent:
+            reader = PayloadReader(p)
+            assert reader.read_uint() == 6
+            chunks.append(bytes(reader.read_bytes()))
+        sent.clear()
+        return chunks
+
+    data = bytes(range(256)) * 10
+    stream.write_large(bytearray(data), 1000)
+    assert sent_chunks() == [data[0:1000], data[1000:2000], data[2000:]]
+
+    path = tmp_path / "blob.bin"
+    path.write_bytes(data)
+    assert stream.send_file(str(path), 1024) == len(data)
+    chunks = sent_chunks()
+    assert [len(c) for c in chunks] == [1024, 1024, 512]
+    assert b"".join(chunks) == data
+
+    with pytest.raises(ValueError):
+        stream.write_large(data, 0)
+    with pytest.raises(RuntimeError):
+        stream.send_file(str(tmp_path / "missing.bin"))
+
+
+def test_payload_reader_read_all():
+    """
+    Tests decoding a whole payload in one call with a compiled PayloadSchema.
+    """
+    ParamType = _bindings.ParamType
+    schema = _bindings.PayloadSchema(
+        [ParamType.STRING, ParamType.INT, ParamType.UINT, ParamType.FLOAT, ParamType.BOOL, ParamType.BYTES]
+    )
+    assert len(schema) == 6
+
+    payload = (
+        PayloadBuilder(0x20)
+        .add_param("name")
+        .add_param(-32000)
+        .add_param(4000000000)
+        .add_param(2.5)
+        .add_param(True)
+        .add_param(b"\x00\xff")
+        .build()
+    )
+    reader = PayloadReader(payload)
+    assert reader.read_all(schema) == ("name", -32000, 4000000000, 2.5, True, b"\x00\xff")
+    assert not reader.has_more()
+
+    # Reading past the end of the payload surfaces an error instead of garbage
+    short = PayloadBuilder(0x21).add_param("only").build()
+    with pytest.raises(Exception):
+        PayloadReader(short).read_all(schema)
+
+
+def test_payload_view_reads_in_place():
+    """
+    Tests that a PayloadView decodes the same values as a PayloadReader and that
+    read_bytes_view() returns a memoryview into the payload itself.
+    """
+    blob = bytes(range(256)) * 16
+    payload = PayloadBuilder(0x22).add_param("file").add_param(-5).add_param(blob).add_param(True).build()
+
+    view = _bindings.PayloadView(payload)
+    assert view.op_code == 0x22
+    assert view.read_string() == "file"
+    assert view.read_int() == -5
+    assert view.peek_next_param_size() == len(blob)
+    blob_view = view.read_bytes_view()
+    assert isinstance(blob_view, memoryview)
+    assert blob_view == blob
+    assert view.read_bool() is True
+    assert not view.has_more()
+
+    # The view points into the payload's own parameter buffer
+    assert blob_view.obj is payload
+
+    # read_all() with BYTES_VIEW, and a PayloadReader constructed over the view
+    ParamType = _bindings.ParamType
+    schema = _bindings.PayloadSchema([ParamType.STRING, ParamType.INT, ParamType.BYTES_VIEW, ParamType.BOOL])
+    name, number, data, flag = _bindings.PayloadView(payload).read_all(schema)
+    assert (name, number, bytes(data), flag) == ("file", -5, blob, True)
+    assert PayloadReader(_bindings.PayloadView(payload)).read_string() == "file"
+
+
+def test_payload_view_scalars_match_reader():
+    """
+    Tests that PayloadView decodes every integer width, floats and bools exactly
+    like PayloadReader, and that a size mismatch does not advance the view.
+    """
+    from ObscuraProto import compile_schema, uint
+
+    ints = (-5, -300, -70000, -(2**40), 2**31 - 1)
+    uints = (200, 60000, 2**32 - 1, 2**64 - 1)
+    schema = compile_schema(*([int] * len(ints)), *([uint] * len(uints)), float, bool, bool)
+    values = (*ints, *uints, 0.1, True, False)
+    payload = PayloadBuilder.build_from(0x25, values, schema)
+
+    assert _bindings.PayloadView(payload).read_all(schema) == PayloadReader(payload).read_all(schema) == values
+
+    fp = PayloadBuilder(0x26).add_param(2.5).add_param("next").build()
+    view = _bindings.PayloadView(fp)
+    with pytest.raises(RuntimeError):
+        view.read_bool()
+    assert view.read_float() == 2.5
+    assert view.read_string() == "next"
+
+
+def test_payload_builder_build_from():
+    """
+    Tests encoding a tuple of values in one call and that it round-trips
+    through the same schema with read_all().
+    """
+    from ObscuraProto import compile_schema, uint
+
+    schema = compile_schema(str, int, uint, float, bool, bytes)
+    values = ("sensor", -70000, 300, 0.1, False, bytearray(b"raw"))
+
+    payload = PayloadBuilder.build_from(0x30, values, schema)
+    assert payload.op_code == 0x30
+
+    reader = PayloadReader(payload)
+    decoded = reader.read_all(schema)
+    assert decoded == ("sensor", -70000, 300, 0.1, False, b"raw")
+    assert not reader.has_more()
+
+    # Integers use the narrowest width of the schema's signedness; floats are always doubles
+    reader = PayloadReader(PayloadBuilder.build_from(0x31, (-1, 255, 200, 1.5), compile_schema(int, uint, int, float)))
+    assert reader.peek_next_param_size() == 1
+    assert reader.read_int() == -1
+    assert reader.peek_next_param_size() == 1
+    assert reader.read_uint() == 255
+    assert reader.peek_next_param_size() == 2
+    assert reader.read_int() == 200
+    assert reader.peek_next_param_size() == 8
+    assert reader.read_float() == 1.5
+
+    with pytest.raises(ValueError):
+        PayloadBuilder.build_from(0x32, ("too", "many"), compile_schema(str))
+    with pytest.raises(TypeError):
+        PayloadBuilder.build_from(0x33, ("not an int",), compile_schema(int))
+    with pytest.raises(TypeError):
+        compile_schema(dict)
+
+
+def test_numeric_array_params():
+    """
+    Tests that typed arrays are encoded from buffer-protocol objects as packed
+    little-endian bytes and decoded into typed memoryviews, in place with a PayloadView.
+    """
+    import array
+    import struct
+
+    from ObscuraProto import compile_schema, float32_array, float64_array, int32_array, int64_array
+
+    ParamType = _bindings.ParamType
+    samples = array.array("f", [0.5, -1.25, 3.0])
+    counts = array.array("i", [1, -2, 2**31 - 1])
+
+    payload = PayloadBuilder(0x40).add_array(samples, ParamType.FLOAT32_ARRAY).add_param("tail").build()
+    # The wire form is an ordinary bytes parameter holding little-endian elements
+    assert bytes(PayloadReader(payload).read_bytes()) == struct.pack("<3f", 0.5, -1.25, 3.0)
+
+    view = _bindings.PayloadView(payload)
+    decoded = view.read_array(ParamType.FLOAT32_ARRAY)
+    assert decoded.format == "f"
+    assert decoded.tolist() == [0.5, -1.25, 3.0]
+    assert view.read_string() == "tail"
+
+    copied = PayloadReader(payload).read_array(ParamType.FLOAT32_ARRAY)
+    assert copied.tolist() == [0.5, -1.25, 3.0]
+
+    schema = compile_schema(int32_array, int64_array, float32_array, float64_array)
+    values = (counts, array.array("q", [-(2**40)]), samples, memoryview(struct.pack("=2d", 1.5, 2.5)).cast("d"))
+    payload = PayloadBuilder.build_from(0x41, values, schema)
+    a, b, c, d = _bindings.PayloadView(payload).read_all(schema)
+    assert (a.tolist(), b.tolist(), c.tolist(), d.tolist()) == (
+        [1, -2, 2**31 - 1],
+        [-(2**40)],
+        [0.5, -1.25, 3.0],
+        [1.5, 2.5],
+    )
+    assert PayloadReader(payload).read_all(schema)[0].tolist() == [1, -2, 2**31 - 1]
+
+    # Element type and width must match the array type
+    with pytest.raises(TypeError):
+        PayloadBuilder(0x42).add_array(samples, ParamType.INT32_ARRAY)
+    with pytest.raises(TypeError):
+        PayloadBuilder(0x42).add_array(array.array("d", [1.0]), ParamType.FLOAT32_ARRAY)
+    with pytest.raises(ValueError):
+        PayloadBuilder(0x42).add_array(samples, ParamType.BYTES)
+    with pytest.raises(RuntimeError):
+        _bindings.PayloadView(PayloadBuilder(0x43).add_param(b"\x00" * 6).build()).read_array(ParamType.INT32_ARRAY)
+
+
+def test_request_pool_limit():
+    """
+    Tests that the native request pool limit can be read back and must be positive.
+    """
+    previous = _bindings.max_request_threads()
+    try:
+        _bindings.set_max_request_threads(4)
+        assert _bindings.max_request_threads() == 4
+        with pytest.raises(ValueError):
+            _bindings.set_max_request_threads(0)
+        assert _bindings.max_request_threads() == 4
+    finally:
+        _bindings.set_max_request_threads(previous)
+
+
+def test_crypto_batch_round_trip():
+    """
+    Tests that encrypt_batch/decrypt_batch round-trip a batch of messages,
+    both from a list of buffers and from a packed buffer with offsets.
+    """
+    Crypto = _bindings.Crypto
+    Crypto.init()
+    client_kx = Crypto.generate_kx_keypair()
+    server_kx = Crypto.generate_kx_keypair()
+    key = Crypto.client_compute_session_keys(client_kx, server_kx.public_key).tx
+
+    messages = [b"first", bytearray(b""), memoryview(b"third message"), b"x" * 1000]
+
+    data, offsets = Crypto.encrypt_batch(key, messages, threads=2)
+    assert isinstance(data, bytes)
+    assert len(offsets) == len(messages) + 1
+    assert offsets[0] == 0 and offsets[-1] == len(data)
+
+    # Each ciphertext decrypts on its own and as part of the packed batch
+    second = data[offsets[1] : offsets[2]]
+    assert bytes(Crypto.decrypt(list(second), key)) == b""
+
+    expected = [bytes(m) for m in messages]
+    plain, plain_offsets = Crypto.decrypt_batch(key, data, offsets, threads=3)
+    assert [plain[plain_offsets[i] : plain_offsets[i + 1]] for i in range(len(messages))] == expected
+
+    ciphertexts = [data[offsets[i] : offsets[i + 1]] for i in range(len(messages))]
+    plain, _ = Crypto.decrypt_batch(key, ciphertexts)
+    assert plain == b"".join(expected)
+
+    with pytest.raises(ValueError):
+        Crypto.decrypt_batch(key, data, [0, len(data) + 1])
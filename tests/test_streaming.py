@@ -18,6 +18,8 @@ except ImportError as e:
     pytest.fail(f"Could not import the ObscuraProto package: {e}. Searched in: {sys.path}", pytrace=False)
 
 PORT = 9005
+COLLECT_PORT = 9015
+COLLECT_LIMIT_PORT = 9021
 
 
 @pytest.fixture(scope="module")
@@ -108,9 +110,92 @@ def test_bidirectional_streaming(crypto_init, capsys):
         assert client_chunks[0] == b"echo:Hello "
         assert client_chunks[1] == b"echo:World!"
 
+        # Chunks are delivered natively as bytes, not as lists of ints
+        assert all(type(chunk) is bytes for chunk in server_chunks + client_chunks)
+
     finally:
         client.disconnect()
         server.stop()
         time.sleep(0.1)
         captured = capsys.readouterr()
         print(captured.out)
+
+
+def test_write_large_reassembled_with_on_complete(crypto_init):
+    """
+    Tests that a large write split by write_large() with the default chunk
+    size arrives at an @on_complete handler as a single bytes object.
+    """
+    data = os.urandom(300_000)
+    received = []
+    done = threading.Event()
+
+    server = op.Server()
+
+    @server.on_incoming_stream
+    def handle_stream(stream: op.Stream):
+        @stream.on_complete
+        def on_complete(message: bytes):
+            received.append(message)
+            done.set()
+
+    client = op.Client(server.public_key)
+
+    @client.on_ready
+    def on_ready():
+        stream = client.start_stream()
+        stream.write_large(data)
+        stream.end()
+
+    try:
+        server.start(COLLECT_PORT)
+        time.sleep(0.1)
+        client.connect(f"ws://localhost:{COLLECT_PORT}")
+
+        assert done.wait(timeout=5), "Reassembled stream data was not delivered"
+        assert len(received) == 1
+        assert type(received[0]) is bytes
+        assert received[0] == data
+    finally:
+        client.disconnect()
+        server.stop()
+        time.sleep(0.1)
+
+
+def test_on_complete_cancels_stream_over_max_size(crypto_init):
+    """
+    Tests that a peer streaming more than max_size bytes to an @on_complete
+    handler gets the stream cancelled and the handler is never called.
+    """
+    received = []
+    cancelled = threading.Event()
+
+    server = op.Server()
+
+    @server.on_incoming_stream
+    def handle_stream(stream: op.Stream):
+        @stream.on_complete(max_size=4096)
+        def on_complete(message: bytes):
+            received.append(message)
+
+    client = op.Client(server.public_key)
+
+    @client.on_ready
+    def on_ready():
+        stream = client.start_stream()
+        stream.on_cancel(cancelled.set)
+        stream.write_large(os.urandom(64 * 1024), chunk_size=1024)
+        stream.end()
+
+    try:
+        server.start(COLLECT_LIMIT_PORT)
+        time.sleep(0.1)
+        client.connect(f"ws://localhost:{COLLECT_LIMIT_PORT}")
+
+        assert cancelled.wait(timeout=5), "Oversized stream was not cancelled"
+        time.sleep(0.2)
+        assert received == []
+    finally:
+        client.disconnect()
+        server.stop()
+        time.sleep(0.1)
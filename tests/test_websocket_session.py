@@ -1,3 +1,5 @@
+import asyncio
+import concurrent.futures
 import os
 import sys
 import threading
@@ -21,6 +23,15 @@ OP_S2C_RESPONSE = 0x8001
 OP_S2C_UNHANDLED = 0x8002
 
 PORT = 9003
+BATCH_PORT = 9012
+REQUEST_PORT = 9013
+BROADCAST_PORT = 9014
+PIPELINE_PORT = 9016
+STATS_PORT = 9017
+TIMEOUT_PORT = 9018
+EXECUTOR_PORT = 9020
+TIMEOUT_POOL_PORT = 9022
+ASYNC_TIMEOUT_PORT = 9023
 
 
 @pytest.fixture(scope="module")
@@ -140,3 +151,423 @@ def test_websocket_session(crypto_init, capsys):
         print(captured.out)
         print(captured.err)
         print("[TEST] Cleanup complete.")
+
+
+def test_batched_payload_handler(crypto_init, capsys):
+    """
+    Tests that a batched handler receives every payload, in order, grouped
+    into lists of at most max_batch items.
+    """
+    total = 50
+    max_batch = 8
+    client_ready = threading.Event()
+    all_received = threading.Event()
+    batches = []
+
+    server = op.Server()
+
+    @server.on_anon_payload_batch(OP_C2S_ECHO, max_batch=max_batch, max_delay_us=20000)
+    def handle_batch(batch):
+        batches.append(batch)
+        if sum(len(b) for b in batches) >= total:
+            all_received.set()
+
+    client = op.Client(server.public_key)
+
+    @client.on_ready
+    def on_ready():
+        client_ready.set()
+
+    try:
+        server.start(BATCH_PORT)
+        time.sleep(0.1)
+        client.connect(f"ws://localhost:{BATCH_PORT}")
+        assert client_ready.wait(timeout=5), "Client did not become ready"
+
+        for i in range(total):
+            client.send(op.PayloadBuilder(OP_C2S_ECHO).add_param(op.uint(i)).build())
+
+        assert all_received.wait(timeout=5), "Not all payloads were delivered"
+
+        assert all(1 <= len(batch) <= max_batch for batch in batches)
+        assert len(batches) < total, "Payloads were not batched"
+        received = []
+        for batch in batches:
+            for hdl, payload in batch:
+                assert isinstance(hdl, op.ConnectionHdl)
+                received.append(op.PayloadReader(payload).read_uint())
+        assert received == list(range(total))
+    finally:
+        client.disconnect()
+        server.stop()
+        time.sleep(0.1)
+
+
+def test_concurrent_async_requests(crypto_init, capsys):
+    """
+    Tests that many concurrent async_request() calls complete through the native
+    request path, each with its own response.
+    """
+    client_ready = threading.Event()
+    server = op.Server()
+
+    @server.on_anon_request(OP_C2S_ECHO)
+    def handle_double(hdl: op.ConnectionHdl, value: int) -> op.Payload:
+        return op.PayloadBuilder(OP_S2C_RESPONSE).add_param(value * 2).build()
+
+    client = op.Client(server.public_key)
+
+    @client.on_ready
+    def on_ready():
+        client_ready.set()
+
+    async def run_requests(count):
+        requests = [client.async_request(op.PayloadBuilder(OP_C2S_ECHO).add_param(i).build()) for i in range(count)]
+        responses = await asyncio.wait_for(asyncio.gather(*requests), timeout=10)
+        return [op.PayloadReader(response).read_int() for response in responses]
+
+    try:
+        server.start(REQUEST_PORT)
+        time.sleep(0.1)
+        client.connect(f"ws://localhost:{REQUEST_PORT}")
+        assert client_ready.wait(timeout=5), "Client did not become ready"
+
+        assert asyncio.run(run_requests(20)) == [i * 2 for i in range(20)]
+    finally:
+        client.disconnect()
+        server.stop()
+        time.sleep(0.1)
+
+
+def test_request_many_returns_responses_in_order(crypto_init, capsys):
+    """
+    Tests that request_many() and async_request_many() pipeline requests with a
+    bounded window and return the responses in request order.
+    """
+    client_ready = threading.Event()
+    server = op.Server()
+
+    @server.on_anon_request(OP_C2S_ECHO)
+    def handle_double(hdl: op.ConnectionHdl, value: int) -> op.Payload:
+        return op.PayloadBuilder(OP_S2C_RESPONSE).add_param(value * 2).build()
+
+    client = op.Client(server.public_key)
+
+    @client.on_ready
+    def on_ready():
+        client_ready.set()
+
+    payloads = [op.PayloadBuilder(OP_C2S_ECHO).add_param(i).build() for i in range(30)]
+
+    try:
+        server.start(PIPELINE_PORT)
+        time.sleep(0.1)
+        client.connect(f"ws://localhost:{PIPELINE_PORT}")
+        assert client_ready.wait(timeout=5), "Client did not become ready"
+
+        responses = client.request_many(payloads, max_in_flight=4)
+        assert [op.PayloadReader(r).read_int() for r in responses] == [i * 2 for i in range(30)]
+
+        responses = asyncio.run(asyncio.wait_for(client.async_request_many(payloads, max_in_flight=4), timeout=10))
+        assert [op.PayloadReader(r).read_int() for r in responses] == [i * 2 for i in range(30)]
+
+        with pytest.raises(ValueError):
+            client.request_many(payloads, max_in_flight=0)
+    finally:
+        client.disconnect()
+        server.stop()
+        time.sleep(0.1)
+
+
+def test_stats_count_traffic_and_requests(crypto_init, capsys):
+    """
+    Tests that stats() counts handled requests per opcode and request round trips,
+    and that the result renders as Prometheus text.
+    """
+    client_ready = threading.Event()
+    server = op.Server()
+
+    @server.on_anon_request(OP_C2S_ECHO)
+    def handle_double(hdl: op.ConnectionHdl, value: int) -> op.Payload:
+        return op.PayloadBuilder(OP_S2C_RESPONSE).add_param(value * 2).build()
+
+    client = op.Client(server.public_key)
+
+    @client.on_ready
+    def on_ready():
+        client_ready.set()
+
+    try:
+        server.start(STATS_PORT)
+        time.sleep(0.1)
+        client.connect(f"ws://localhost:{STATS_PORT}")
+        assert client_ready.wait(timeout=5), "Client did not become ready"
+
+        payloads = [op.PayloadBuilder(OP_C2S_ECHO).add_param(i).build() for i in range(5)]
+        client.request_many(payloads, max_in_flight=2)
+
+        client_stats = client.stats()
+        assert client_stats["request_rtt_us"]["count"] == 5
+        assert client_stats["sent"]["messages"] == 5
+        assert client_stats["received"]["messages"] == 5
+
+        server_stats = server.stats()
+        assert server_stats["opcodes"][OP_C2S_ECHO]["messages"] == 5
+        assert server_stats["opcodes"][OP_C2S_ECHO]["handler_us"]["count"] == 5
+        assert server_stats["sent"]["messages"] == 5
+
+        text = op.stats_to_prometheus(server_stats)
+        assert f'obscuraproto_opcode_received_messages_total{{opcode="0x{OP_C2S_ECHO:04x}"}} 5' in text
+        assert "# TYPE obscuraproto_opcode_received_messages_total counter" in text
+        assert "# TYPE obscuraproto_handler_seconds summary" in text
+        assert f'obscuraproto_handler_seconds_count{{opcode="0x{OP_C2S_ECHO:04x}"}} 5' in text
+        assert text.count("# TYPE obscuraproto_handler_seconds ") == 1
+    finally:
+        client.disconnect()
+        server.stop()
+        time.sleep(0.1)
+
+
+def test_request_timeout(crypto_init, capsys):
+    """
+    Tests that sync_request and async_request raise TimeoutError when the response
+    does not arrive within the timeout, and succeed when it does.
+    """
+    client_ready = threading.Event()
+    server = op.Server()
+
+    @server.on_anon_request(OP_C2S_ECHO)
+    def handle_slow(hdl: op.ConnectionHdl, delay_ms: int) -> op.Payload:
+        time.sleep(delay_ms / 1000)
+        return op.PayloadBuilder(OP_S2C_RESPONSE).add_param(delay_ms).build()
+
+    client = op.Client(server.public_key)
+
+    @client.on_ready
+    def on_ready():
+        client_ready.set()
+
+    def request(delay_ms):
+        return op.PayloadBuilder(OP_C2S_ECHO).add_param(delay_ms).build()
+
+    try:
+        server.start(TIMEOUT_PORT)
+        time.sleep(0.1)
+        client.connect(f"ws://localhost:{TIMEOUT_PORT}")
+        assert client_ready.wait(timeout=5), "Client did not become ready"
+
+        response = client.sync_request(request(0), timeout=5)
+        assert op.PayloadReader(response).read_int() == 0
+
+        started = time.monotonic()
+        with pytest.raises(TimeoutError):
+            client.sync_request(request(800), timeout=0.2)
+        assert time.monotonic() - started < 0.7
+
+        with pytest.raises(TimeoutError):
+            asyncio.run(client.async_request(request(800), timeout=0.2))
+
+        with pytest.raises(ValueError):
+            client.sync_request(request(0), timeout=0)
+    finally:
+        time.sleep(1.0)  # let the slow handlers finish before shutting down
+        client.disconnect()
+        server.stop()
+        time.sleep(0.1)
+
+
+def test_broadcast_anonymous(crypto_init, capsys):
+    """
+    Tests that one broadcast call reaches every connected anonymous client.
+    """
+    client_count = 3
+    server = op.Server()
+    hdls = []
+    all_joined = threading.Event()
+
+    @server.on_anon_payload(OP_C2S_ECHO)
+    def handle_join(hdl: op.ConnectionHdl, payload: op.Payload):
+        hdls.append(hdl)
+        if len(hdls) == client_count:
+            all_joined.set()
+
+    clients = []
+    received = []
+    all_received = threading.Event()
+
+    for _ in range(client_count):
+        client = op.Client(server.public_key)
+        ready = threading.Event()
+        client.on_ready(ready.set)
+
+        @client.on_payload(OP_S2C_RESPONSE)
+        def handle_update(text: str):
+            received.append(text)
+            if len(received) == client_count:
+                all_received.set()
+
+        clients.append((client, ready))
+
+    try:
+        server.start(BROADCAST_PORT)
+        time.sleep(0.1)
+        for client, ready in clients:
+            client.connect(f"ws://localhost:{BROADCAST_PORT}")
+            assert ready.wait(timeout=5), "Client did not become ready"
+            client.send(op.PayloadBuilder(OP_C2S_ECHO).build())
+
+        assert all_joined.wait(timeout=5), "Not every client reached the server"
+        update = op.PayloadBuilder(OP_S2C_RESPONSE).add_param("state").build()
+        assert server.broadcast_anonymous(update, hdls, workers=2) == client_count
+
+        assert all_received.wait(timeout=5), "Broadcast did not reach every client"
+        assert received == ["state"] * client_count
+    finally:
+        for client, _ in clients:
+            client.disconnect()
+        server.stop()
+        time.sleep(0.1)
+
+
+def test_timed_out_requests_are_bounded_by_the_request_pool(crypto_init, capsys):
+    """
+    Tests that timed-out requests occupy at most max_request_threads native threads
+    and that requests abandoned while queued are never sent.
+    """
+    server = op.Server()
+    handled = []
+
+    @server.on_anon_request(OP_C2S_ECHO)
+    def handle_slow(hdl: op.ConnectionHdl) -> op.Payload:
+        handled.append(hdl)
+        time.sleep(0.3)
+        return op.PayloadBuilder(OP_S2C_RESPONSE).build()
+
+    client = op.Client(server.public_key)
+    client_ready = threading.Event()
+    client.on_ready(client_ready.set)
+
+    previous = op.max_request_threads()
+    op.set_max_request_threads(2)
+    try:
+        server.start(TIMEOUT_POOL_PORT)
+        time.sleep(0.1)
+        client.connect(f"ws://localhost:{TIMEOUT_POOL_PORT}")
+        assert client_ready.wait(timeout=5), "Client did not become ready"
+
+        for _ in range(6):
+            with pytest.raises(TimeoutError):
+                client.sync_request(op.PayloadBuilder(OP_C2S_ECHO).build(), timeout=0.02)
+
+        time.sleep(1.0)  # let the two running requests finish
+        assert 1 <= len(handled) <= 3
+    finally:
+        op.set_max_request_threads(previous)
+        client.disconnect()
+        server.stop()
+        time.sleep(0.1)
+
+
+def test_payload_handler_on_executor_with_overload(crypto_init, capsys):
+    """
+    Tests that a handler registered with an executor runs off the I/O thread, that
+    payloads beyond max_pending go to on_overload, and that the I/O thread keeps
+    dispatching while the handler is blocked.
+    """
+    server = op.Server()
+    pool = concurrent.futures.ThreadPoolExecutor(max_workers=1)
+    release = threading.Event()
+    overloaded = []
+    handled = []
+    handler_threads = set()
+    overload_threads = set()
+
+    def on_overload(hdl, payload):
+        overload_threads.add(threading.get_ident())
+        overloaded.append(payload.op_code)
+
+    @server.on_anon_payload(OP_C2S_ECHO, executor=pool, max_pending=1, on_overload=on_overload)
+    def handle_slow(hdl: op.ConnectionHdl, index: op.uint):
+        handler_threads.add(threading.get_ident())
+        release.wait(timeout=5)
+        handled.append(index)
+        server.send_anonymous(hdl, op.PayloadBuilder(OP_S2C_RESPONSE).add_param(op.uint(index)).build())
+
+    client = op.Client(server.public_key)
+    client_ready = threading.Event()
+    client.on_ready(client_ready.set)
+    replied = threading.Event()
+
+    @client.on_payload(OP_S2C_RESPONSE)
+    def on_reply(index: op.uint):
+        replied.set()
+
+    try:
+        server.start(EXECUTOR_PORT)
+        time.sleep(0.1)
+        client.connect(f"ws://localhost:{EXECUTOR_PORT}")
+        assert client_ready.wait(timeout=5), "Client did not become ready"
+
+        for i in range(3):
+            client.send(op.PayloadBuilder(OP_C2S_ECHO).add_param(op.uint(i)).build())
+
+        deadline = time.monotonic() + 5
+        while len(overloaded) < 2 and time.monotonic() < deadline:
+            time.sleep(0.01)
+        assert overloaded == [OP_C2S_ECHO, OP_C2S_ECHO]
+
+        release.set()
+        assert replied.wait(timeout=5), "Offloaded handler did not reply"
+        assert handled == [0]
+        assert handler_threads.isdisjoint(overload_threads)
+    finally:
+        release.set()
+        pool.shutdown(wait=True)
+        client.disconnect()
+        server.stop()
+        time.sleep(0.1)
+
+
+def test_timed_out_async_requests_are_never_sent(crypto_init, capsys):
+    """
+    Tests that an async request whose timeout expires while it is still queued
+    for a native thread is dropped and never reaches the server.
+    """
+    server = op.Server()
+    handled = []
+
+    @server.on_anon_request(OP_C2S_ECHO)
+    def handle_slow(hdl: op.ConnectionHdl) -> op.Payload:
+        handled.append(hdl)
+        time.sleep(0.3)
+        return op.PayloadBuilder(OP_S2C_RESPONSE).build()
+
+    client = op.Client(server.public_key)
+    client_ready = threading.Event()
+    client.on_ready(client_ready.set)
+
+    async def run_requests():
+        # The first request holds the only native thread; the rest time out in the queue.
+        requests = [client.async_request(op.PayloadBuilder(OP_C2S_ECHO).build(), timeout=5)]
+        requests += [client.async_request(op.PayloadBuilder(OP_C2S_ECHO).build(), timeout=0.02) for _ in range(5)]
+        return await asyncio.gather(*requests, return_exceptions=True)
+
+    previous = op.max_request_threads()
+    op.set_max_request_threads(1)
+    try:
+        server.start(ASYNC_TIMEOUT_PORT)
+        time.sleep(0.1)
+        client.connect(f"ws://localhost:{ASYNC_TIMEOUT_PORT}")
+        assert client_ready.wait(timeout=5), "Client did not become ready"
+
+        results = asyncio.run(run_requests())
+        assert isinstance(results[0], op.Payload)
+        assert all(isinstance(result, asyncio.TimeoutError) for result in results[1:])
+
+        time.sleep(0.5)  # give the native thread time to reach the abandoned requests
+        assert len(handled) == 1
+    finally:
+        op.set_max_request_threads(previous)
+        client.disconnect()
+        server.stop()
+        time.sleep(0.1)